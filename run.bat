@@ -46,7 +46,7 @@ if not exist "bin" mkdir bin
 echo Compilando...
 
 REM Compilar con g++
-g++ -c main.cpp -I"%SFML_PATH%\include" -std=c++17 -o bin\main.o
+g++ -c main.cpp -I"%SFML_PATH%\include" -std=c++17 -O3 -fno-trapping-math -ffp-contract=off -pthread -o bin\main.o
 
 if errorlevel 1 (
     echo.
@@ -64,7 +64,7 @@ if errorlevel 1 (
 echo Enlazando...
 
 REM Enlazar (modo dinámico)
-g++ bin\main.o -o bin\pong.exe -L"%SFML_PATH%\lib" -lsfml-graphics -lsfml-window -lsfml-system -lopengl32 -lwinmm -lgdi32
+g++ bin\main.o -o bin\pong.exe -pthread -L"%SFML_PATH%\lib" -lsfml-graphics -lsfml-window -lsfml-system -lopengl32 -lwinmm -lgdi32
 
 if errorlevel 1 (
     echo.
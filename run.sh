@@ -45,7 +45,7 @@ mkdir -p bin
 echo "Compilando..."
 
 # Compilar con g++
-g++ -c main.cpp -I"$SFML_PATH/include" -std=c++17 -o bin/main.o
+g++ -c main.cpp -I"$SFML_PATH/include" -std=c++17 -O3 -fno-trapping-math -ffp-contract=off -pthread -o bin/main.o
 
 if [ $? -ne 0 ]; then
     echo ""
@@ -62,7 +62,7 @@ fi
 echo "Enlazando..."
 
 # Enlazar (modo dinámico)
-g++ bin/main.o -o bin/pong.exe -L"$SFML_PATH/lib" -lsfml-graphics -lsfml-window -lsfml-system -lopengl32 -lwinmm -lgdi32
+g++ bin/main.o -o bin/pong.exe -pthread -L"$SFML_PATH/lib" -lsfml-graphics -lsfml-window -lsfml-system -lopengl32 -lwinmm -lgdi32
 
 if [ $? -ne 0 ]; then
     echo ""
@@ -3,7 +3,9 @@
 #include <SFML/Graphics.hpp>
 #include "QLearningAgent.h"
 #include "Ball.h"
+#include "AgentControl.h"
 #include <vector>
+#include <memory>
 
 using namespace std;
 
@@ -23,28 +25,22 @@ private:
     float reactionTimer;
     int score;
     
-    vector<float> lastState;
+    AgentState lastState;
+    bool hasLastState;
     int lastAction;
     bool trainingEnabled;
     
     // Normalize values for neural network input
-    vector<float> normalizeState(float ballX, float ballY, float ballVx, float ballVy,
-                                  float paddleY, float windowHeight) {
+    AgentState normalizeState(float ballX, float ballY, float ballVx, float ballVy,
+                              float paddleY, float windowHeight) const {
         // Normalize to [0, 1] range
-        vector<float> state(6);
-        state[0] = ballX / 1280.0f;  // Normalized ball X position
-        state[1] = ballY / 720.0f;  // Normalized ball Y position
-        state[2] = (ballVx + 1.0f) / 2.0f;  // Normalized velocity X (assuming -1 to 1)
-        state[3] = (ballVy + 1.0f) / 2.0f;  // Normalized velocity Y
-        state[4] = paddleY / 720.0f;  // Normalized paddle Y position
-        state[5] = (paddleY + shape.getSize().y / 2.0f) / 720.0f;  // Normalized paddle center
-        
-        return state;
+        return MatchPhysics::normalizeState(ballX, ballY, ballVx, ballVy,
+                                            paddleY, shape.getSize().y);
     }
     
 public:
     AIPlayer(float x, float y, float width, float height, DifficultyLevel diff = DifficultyLevel::Medium)
-        : difficulty(diff), score(0), lastAction(1), trainingEnabled(true) {
+        : difficulty(diff), score(0), hasLastState(false), lastAction(1), trainingEnabled(true) {
         shape.setPosition(x, y);
         shape.setSize(sf::Vector2f(width, height));
         shape.setFillColor(sf::Color(65, 65, 255));
@@ -58,7 +54,7 @@ public:
              float learningRate, float epsilonDecay, int hiddenSize, 
              float discountFactor, int batchSize, DifficultyLevel diff = DifficultyLevel::Medium)
         : agent(6, 3, hiddenSize, learningRate, epsilonDecay, discountFactor, batchSize),
-          difficulty(diff), score(0), lastAction(1), trainingEnabled(true) {
+          difficulty(diff), score(0), hasLastState(false), lastAction(1), trainingEnabled(true) {
         shape.setPosition(x, y);
         shape.setSize(sf::Vector2f(width, height));
         shape.setFillColor(sf::Color(65, 65, 255));
@@ -67,13 +63,27 @@ public:
         setDifficulty(diff);
     }
     
+    // Turn this player into a new one with other hyperparameters, keeping
+    // its allocations (see QLearningAgent::reinitialize)
+    void reinitialize(float x, float y, float learningRate, float epsilonDecay, int hiddenSize,
+                      float discountFactor, int batchSize, DifficultyLevel diff = DifficultyLevel::Medium) {
+        agent.reinitialize(hiddenSize, learningRate, epsilonDecay, discountFactor, batchSize);
+        shape.setPosition(x, y);
+        score = 0;
+        hasLastState = false;
+        lastAction = 1;
+        trainingEnabled = true;
+        reactionTimer = 0.0f;
+        setDifficulty(diff);
+    }
+    
     void update(const Ball& ball, float dt, float windowHeight, float windowWidth) {
         // Get current state
         sf::Vector2f ballPos = ball.sprite.getPosition();
         sf::Vector2f ballDir = ball.getDir();
         float paddleY = shape.getPosition().y;
         
-        vector<float> currentState = normalizeState(
+        AgentState currentState = normalizeState(
             ballPos.x, ballPos.y,
             ballDir.x, ballDir.y,
             paddleY, windowHeight
@@ -84,9 +94,10 @@ public:
         
         // Decide action if reaction delay has passed
         if (reactionTimer >= reactionDelay) {
-            int action = agent.selectAction(currentState);
+            int action = agent.selectAction(currentState.data());
             lastAction = action;
             lastState = currentState;
+            hasLastState = true;
             reactionTimer = 0.0f;
         }
         
@@ -94,7 +105,7 @@ public:
         executeAction(lastAction, dt, windowHeight);
         
         // Record experience periodically (every frame when state changes)
-        if (trainingEnabled && !lastState.empty()) {
+        if (trainingEnabled && hasLastState) {
             // Record experience with current state as next state
             recordExperience(false, false, false, false, currentState);
         }
@@ -107,44 +118,38 @@ public:
     
     void executeAction(int action, float dt, float windowHeight) {
         sf::Vector2f pos = shape.getPosition();
-        sf::Vector2f size = shape.getSize();
-        
-        // Action: 0 = up, 1 = stay, 2 = down
-        if (action == 0) {
-            pos.y -= speed * dt;
-            if (pos.y < 0) {
-                pos.y = 0;
-            }
-        } else if (action == 2) {
-            pos.y += speed * dt;
-            if (pos.y + size.y > windowHeight) {
-                pos.y = windowHeight - size.y;
-            }
-        }
-        // action == 1 means stay, do nothing
-        
+        pos.y = movePaddle(pos.y, action, dt, windowHeight);
         shape.setPosition(pos);
     }
     
+    // Paddle Y after applying an action for dt seconds
+    // Action: 0 = up, 1 = stay, 2 = down
+    float movePaddle(float y, int action, float dt, float windowHeight) const {
+        return MatchPhysics::movePaddleY(y, action, speed, dt, shape.getSize().y, windowHeight);
+    }
+    
+    // Movement parameters for the headless simulation (see MatchPhysics.h)
+    PaddleParams getPaddleParams() const {
+        return PaddleParams(speed, reactionDelay);
+    }
+    
     // Record experience for training
     void recordExperience(bool hitBall, bool missedBall, bool scored, bool opponentScored, 
-                         const vector<float>& currentState) {
-        if (!trainingEnabled || lastState.empty()) return;
+                         const AgentState& currentState) {
+        if (!trainingEnabled || !hasLastState) return;
         
         float reward = agent.calculateReward(
             lastState, currentState,
             hitBall, missedBall, scored, opponentScored
         );
         
-        Experience exp(lastState, lastAction, reward, currentState, false);
-        agent.remember(exp);
+        agent.remember(lastState, lastAction, reward, currentState, false);
     }
     
     // Record final experience when point is scored
     void recordPointExperience(bool wonPoint, bool gameOver = false) {
-        if (!trainingEnabled || lastState.empty()) return;
+        if (!trainingEnabled || !hasLastState) return;
         
-        vector<float> nextState = lastState;
         float reward = wonPoint ? 5.0f : -10.0f;  // Castigo significativo por recibir gol
         
         // Larger reward/penalty if game is over
@@ -152,8 +157,7 @@ public:
             reward = wonPoint ? 50.0f : -100.0f;  // Castigo muy severo por perder partida
         }
         
-        Experience exp(lastState, lastAction, reward, nextState, gameOver);
-        agent.remember(exp);
+        agent.remember(lastState, lastAction, reward, lastState, gameOver);
     }
     
     void setDifficulty(DifficultyLevel level) {
@@ -269,7 +273,7 @@ public:
     }
     
     // Get current state for external use
-    vector<float> getCurrentState(const Ball& ball, float windowHeight) {
+    AgentState getCurrentState(const Ball& ball, float windowHeight) {
         sf::Vector2f ballPos = ball.sprite.getPosition();
         sf::Vector2f ballDir = ball.getDir();
         float paddleY = shape.getPosition().y;
@@ -282,8 +286,8 @@ public:
     }
     
     // Clone the AI player with a new position
-    AIPlayer* clone(float x, float y) const {
-        AIPlayer* cloned = new AIPlayer(
+    unique_ptr<AIPlayer> clone(float x, float y) const {
+        unique_ptr<AIPlayer> cloned(new AIPlayer(
             x, y, 
             shape.getSize().x, shape.getSize().y,
             agent.getLearningRate(),
@@ -292,7 +296,7 @@ public:
             agent.getDiscountFactor(),
             agent.getBatchSize(),
             difficulty
-        );
+        ));
         
         // Copy agent state
         agent.copyTo(cloned->agent);
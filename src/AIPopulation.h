@@ -2,6 +2,7 @@
 
 #include "AIPlayer.h"
 #include <vector>
+#include <memory>
 #include <random>
 #include <algorithm>
 #include <string>
@@ -27,12 +28,15 @@ struct GeneticParams {
           discountFactor(df), batchSize(bs) {}
 };
 
-// Individual in the population
+// Individual in the population.
+// Move-only: the player (network, replay view, results) is owned uniquely,
+// so sorting and reshuffling individuals only moves pointers. Use clone()
+// where an independent copy is really wanted.
 struct AIIndividual {
     string id;  // Alphanumeric ID (4 digits: 0-9, A-Z)
     int generation;
     GeneticParams genes;
-    AIPlayer* player;
+    unique_ptr<AIPlayer> player;
     
     // Fitness metrics
     float fitness;
@@ -42,64 +46,56 @@ struct AIIndividual {
     float winRate;
     
     AIIndividual() 
-        : id("0000"), generation(0), player(nullptr), fitness(0.0f), 
+        : id("0000"), generation(0), fitness(0.0f), 
           wins(0), losses(0), totalMatches(0), winRate(0.0f) {}
     
     AIIndividual(const string& individualId, int gen, const GeneticParams& params, float x, float y)
         : id(individualId), generation(gen), genes(params), fitness(0.0f),
           wins(0), losses(0), totalMatches(0), winRate(0.0f) {
         // Create AI player with genetic parameters
-        player = new AIPlayer(x, y, 15, 100,
-                            params.learningRate,
-                            params.epsilonDecay,
-                            params.hiddenLayerSize,
-                            params.discountFactor,
-                            params.batchSize,
-                            DifficultyLevel::Hard);
+        player.reset(new AIPlayer(x, y, 15, 100,
+                                  params.learningRate,
+                                  params.epsilonDecay,
+                                  params.hiddenLayerSize,
+                                  params.discountFactor,
+                                  params.batchSize,
+                                  DifficultyLevel::Hard));
     }
     
-    ~AIIndividual() {
-        if (player) {
-            delete player;
-            player = nullptr;
-        }
-    }
-    
-    // Copy constructor
-    AIIndividual(const AIIndividual& other) 
-        : id(other.id), generation(other.generation), genes(other.genes),
-          fitness(other.fitness), wins(other.wins), losses(other.losses),
-          totalMatches(other.totalMatches), winRate(other.winRate) {
-        if (other.player) {
-            player = other.player->clone(other.player->getPosition().x, 
-                                        other.player->getPosition().y);
-        } else {
-            player = nullptr;
-        }
+    // Same, on a retired player whose storage is reused (AIPopulation's pool)
+    AIIndividual(const string& individualId, int gen, const GeneticParams& params, float x, float y,
+                 unique_ptr<AIPlayer> recycled)
+        : id(individualId), generation(gen), genes(params), player(move(recycled)), fitness(0.0f),
+          wins(0), losses(0), totalMatches(0), winRate(0.0f) {
+        player->reinitialize(x, y,
+                             params.learningRate,
+                             params.epsilonDecay,
+                             params.hiddenLayerSize,
+                             params.discountFactor,
+                             params.batchSize,
+                             DifficultyLevel::Hard);
     }
     
-    // Assignment operator
-    AIIndividual& operator=(const AIIndividual& other) {
-        if (this != &other) {
-            if (player) delete player;
-            
-            id = other.id;
-            generation = other.generation;
-            genes = other.genes;
-            fitness = other.fitness;
-            wins = other.wins;
-            losses = other.losses;
-            totalMatches = other.totalMatches;
-            winRate = other.winRate;
-            
-            if (other.player) {
-                player = other.player->clone(other.player->getPosition().x,
-                                            other.player->getPosition().y);
-            } else {
-                player = nullptr;
-            }
+    AIIndividual(AIIndividual&&) = default;
+    AIIndividual& operator=(AIIndividual&&) = default;
+    AIIndividual(const AIIndividual&) = delete;
+    AIIndividual& operator=(const AIIndividual&) = delete;
+    
+    // Deep copy: same stats and genes, a cloned player
+    AIIndividual clone() const {
+        AIIndividual copy;
+        copy.id = id;
+        copy.generation = generation;
+        copy.genes = genes;
+        copy.fitness = fitness;
+        copy.wins = wins;
+        copy.losses = losses;
+        copy.totalMatches = totalMatches;
+        copy.winRate = winRate;
+        if (player) {
+            copy.player = player->clone(player->getPosition().x, player->getPosition().y);
         }
-        return *this;
+        return copy;
     }
     
     void recordMatch(bool won) {
@@ -129,15 +125,56 @@ struct AIIndividual {
 
 // Population management
 class AIPopulation {
+public:
+    // One replay buffer for the whole population, whatever its size (about
+    // 20 MB when full); each agent samples the transitions of the last
+    // SHARED_REPLAY_GENERATIONS
+    static constexpr int SHARED_REPLAY_CAPACITY = 1000000;
+    static constexpr int SHARED_REPLAY_GENERATIONS = 3;
+    
 private:
     vector<AIIndividual> individuals;
     int populationSize;
     int currentGeneration;
     int nextIdCounter;  // Counter for generating unique IDs
+    shared_ptr<ReplayBuffer> sharedReplay;
     
-    random_device rd;
-    mt19937 gen;
-    uniform_real_distribution<float> dist;
+    // Indices of individuals by fitness (descending), rebuilt on demand
+    // after fitness or membership changes instead of sorting the objects
+    mutable vector<int> ranking;
+    mutable bool rankingValid;
+    
+    // Players of retired individuals, recycled for new ones so generations
+    // do not reallocate networks, agents and RNG state
+    vector<unique_ptr<AIPlayer>> playerPool;
+    
+    RandomStream rng;  // Genes and ids (child of RandomSeeds)
+    
+    void retirePlayer(unique_ptr<AIPlayer> player) {
+        if (player && (int)playerPool.size() < populationSize) {
+            playerPool.push_back(move(player));
+        }
+    }
+    
+    void retireAll() {
+        for (auto& individual : individuals) {
+            retirePlayer(move(individual.player));
+        }
+        individuals.clear();
+        rankingValid = false;
+    }
+    
+    // Append a new individual to target, on a pooled player when available
+    void addIndividual(vector<AIIndividual>& target, const string& id, int generation,
+                       const GeneticParams& genes, float x, float y) {
+        if (playerPool.empty()) {
+            target.emplace_back(id, generation, genes, x, y);
+        } else {
+            unique_ptr<AIPlayer> recycled = move(playerPool.back());
+            playerPool.pop_back();
+            target.emplace_back(id, generation, genes, x, y, move(recycled));
+        }
+    }
     
     // Generate alphanumeric ID (4 digits: 0-9, A-Z)
     string generateAlphanumericId() {
@@ -146,7 +183,7 @@ private:
         
         string id = "";
         for (int i = 0; i < 4; i++) {
-            id += chars[charDist(gen)];
+            id += chars[charDist(rng)];
         }
         return id;
     }
@@ -161,11 +198,11 @@ public:
         uniform_int_distribution<int> bsDist(16, 64);
         
         return GeneticParams(
-            lrDist(gen),
-            edDist(gen),
-            hlsDist(gen),
-            dfDist(gen),
-            bsDist(gen)
+            lrDist(rng),
+            edDist(rng),
+            hlsDist(rng),
+            dfDist(rng),
+            bsDist(rng)
         );
     }
     
@@ -174,11 +211,11 @@ public:
         uniform_int_distribution<int> coinFlip(0, 1);
         
         return GeneticParams(
-            coinFlip(gen) ? parent1.learningRate : parent2.learningRate,
-            coinFlip(gen) ? parent1.epsilonDecay : parent2.epsilonDecay,
-            coinFlip(gen) ? parent1.hiddenLayerSize : parent2.hiddenLayerSize,
-            coinFlip(gen) ? parent1.discountFactor : parent2.discountFactor,
-            coinFlip(gen) ? parent1.batchSize : parent2.batchSize
+            coinFlip(rng) ? parent1.learningRate : parent2.learningRate,
+            coinFlip(rng) ? parent1.epsilonDecay : parent2.epsilonDecay,
+            coinFlip(rng) ? parent1.hiddenLayerSize : parent2.hiddenLayerSize,
+            coinFlip(rng) ? parent1.discountFactor : parent2.discountFactor,
+            coinFlip(rng) ? parent1.batchSize : parent2.batchSize
         );
     }
     
@@ -189,29 +226,49 @@ public:
         
         GeneticParams mutated = genes;
         
-        if (mutationChance(gen) < mutationRate) {
-            mutated.learningRate = max(0.001f, min(0.05f, genes.learningRate * mutationAmount(gen)));
+        if (mutationChance(rng) < mutationRate) {
+            mutated.learningRate = max(0.001f, min(0.05f, genes.learningRate * mutationAmount(rng)));
         }
-        if (mutationChance(gen) < mutationRate) {
-            mutated.epsilonDecay = max(0.95f, min(0.995f, genes.epsilonDecay * mutationAmount(gen)));
+        if (mutationChance(rng) < mutationRate) {
+            mutated.epsilonDecay = max(0.95f, min(0.995f, genes.epsilonDecay * mutationAmount(rng)));
         }
-        if (mutationChance(gen) < mutationRate) {
+        if (mutationChance(rng) < mutationRate) {
             uniform_int_distribution<int> hlsMutation(-4, 4);
-            mutated.hiddenLayerSize = max(8, min(24, genes.hiddenLayerSize + hlsMutation(gen)));
+            mutated.hiddenLayerSize = max(8, min(24, genes.hiddenLayerSize + hlsMutation(rng)));
         }
-        if (mutationChance(gen) < mutationRate) {
-            mutated.discountFactor = max(0.90f, min(0.99f, genes.discountFactor * mutationAmount(gen)));
+        if (mutationChance(rng) < mutationRate) {
+            mutated.discountFactor = max(0.90f, min(0.99f, genes.discountFactor * mutationAmount(rng)));
         }
-        if (mutationChance(gen) < mutationRate) {
+        if (mutationChance(rng) < mutationRate) {
             uniform_int_distribution<int> bsMutation(-8, 8);
-            mutated.batchSize = max(16, min(64, genes.batchSize + bsMutation(gen)));
+            mutated.batchSize = max(16, min(64, genes.batchSize + bsMutation(rng)));
         }
         
         return mutated;
     }
     
     AIPopulation(int size = 16) 
-        : populationSize(size), currentGeneration(0), nextIdCounter(0), gen(rd()), dist(0.0f, 1.0f) {
+        : populationSize(size), currentGeneration(0), nextIdCounter(0),
+          sharedReplay(make_shared<ReplayBuffer>(SHARED_REPLAY_CAPACITY)),
+          rankingValid(false), rng(RandomSeeds::next()) {
+    }
+    
+    // Take a new stream from RandomSeeds (after its root was set)
+    void reseed() {
+        rng = RandomSeeds::next();
+    }
+    
+    // Point every individual's agent at the shared replay buffer. Called
+    // after the population is (re)built; call again after adding
+    // individuals from outside.
+    void shareReplay() {
+        sharedReplay->beginGeneration(currentGeneration);
+        ReplayView view(sharedReplay, SHARED_REPLAY_GENERATIONS);
+        for (auto& individual : individuals) {
+            if (individual.player) {
+                individual.player->getAgent().setReplayView(view);
+            }
+        }
     }
     
     ~AIPopulation() {
@@ -220,21 +277,22 @@ public:
     
     // Initialize population with random genes
     void initialize(float x, float y) {
-        individuals.clear();
+        retireAll();
         nextIdCounter = 0;
         
         for (int i = 0; i < populationSize; i++) {
             GeneticParams genes = randomGenes();
             string id = generateAlphanumericId();
-            individuals.emplace_back(id, currentGeneration, genes, x, y);
+            addIndividual(individuals, id, currentGeneration, genes, x, y);
         }
+        shareReplay();
         
         cout << "Population initialized with " << populationSize << " individuals" << endl;
     }
     
     // Initialize population based on a base individual with mutations
     void initializeFromBase(const AIIndividual& baseIndividual, float x, float y, float mutationRate = 0.15f) {
-        individuals.clear();
+        retireAll();
         nextIdCounter = 0;
         
         // First individual is the base (will be added by TournamentManager with preserved stats)
@@ -242,8 +300,9 @@ public:
         for (int i = 0; i < populationSize; i++) {
             GeneticParams mutatedGenes = mutate(baseIndividual.genes, mutationRate);
             string id = generateAlphanumericId();
-            individuals.emplace_back(id, currentGeneration, mutatedGenes, x, y);
+            addIndividual(individuals, id, currentGeneration, mutatedGenes, x, y);
         }
+        shareReplay();
         
         cout << "Population initialized with " << populationSize 
              << " individuals based on base individual " << baseIndividual.id << endl;
@@ -254,71 +313,109 @@ public:
         for (auto& individual : individuals) {
             individual.calculateFitness();
         }
+        rankingValid = false;
+    }
+    
+    // Mark the ranking stale after changing fitness or individuals from
+    // outside (non-const getIndividuals() does this already)
+    void invalidateRanking() {
+        rankingValid = false;
+    }
+    
+    // Individual indices by fitness, best first (ties keep population order)
+    const vector<int>& getRanking() const {
+        if (!rankingValid || ranking.size() != individuals.size()) {
+            ranking.resize(individuals.size());
+            for (int i = 0; i < (int)ranking.size(); i++) {
+                ranking[i] = i;
+            }
+            stable_sort(ranking.begin(), ranking.end(),
+                        [this](int a, int b) {
+                            return individuals[a].fitness > individuals[b].fitness;
+                        });
+            rankingValid = true;
+        }
+        return ranking;
     }
     
-    // Sort by fitness (descending)
-    void sortByFitness() {
-        sort(individuals.begin(), individuals.end(),
-             [](const AIIndividual& a, const AIIndividual& b) {
-                 return a.fitness > b.fitness;
-             });
+    // Individual at rank (0 = best)
+    AIIndividual& getRanked(int rank) { return individuals[getRanking()[rank]]; }
+    const AIIndividual& getRanked(int rank) const { return individuals[getRanking()[rank]]; }
+    
+    // Put individual in place of the lowest-ranked one
+    void replaceWorst(AIIndividual&& individual) {
+        AIIndividual& worst = individuals[getRanking().back()];
+        retirePlayer(move(worst.player));
+        worst = move(individual);
+        rankingValid = false;
     }
     
     // Evolve to next generation
     void evolveNextGeneration(float elitePercent = 0.25f, float mutationRate = 0.1f) {
         calculateAllFitness();
-        sortByFitness();
+        const vector<int>& ranked = getRanking();
         
         int eliteCount = max(1, (int)(populationSize * elitePercent));
+        float x = individuals[0].player->getPosition().x;
+        float y = individuals[0].player->getPosition().y;
         
-        // Store elite individuals
+        // Move elite individuals over (the old generation is dropped below;
+        // genes stay readable in the moved-from parents)
         vector<AIIndividual> nextGen;
         for (int i = 0; i < eliteCount; i++) {
-            AIIndividual elite = individuals[i];
+            AIIndividual elite = move(individuals[ranked[i]]);
             elite.generation = currentGeneration + 1;
             elite.resetStats();
-            nextGen.push_back(elite);
+            nextGen.push_back(move(elite));
+        }
+        
+        // The rest of the old generation hands its players to the pool
+        for (auto& individual : individuals) {
+            retirePlayer(move(individual.player));
         }
         
         // Generate offspring to fill the rest
         while (nextGen.size() < populationSize) {
             // Select two random parents from elite
             uniform_int_distribution<int> parentDist(0, eliteCount - 1);
-            int parent1Idx = parentDist(gen);
-            int parent2Idx = parentDist(gen);
+            int parent1Idx = parentDist(rng);
+            int parent2Idx = parentDist(rng);
             
             // Crossover and mutate
-            GeneticParams childGenes = crossover(individuals[parent1Idx].genes, 
-                                                 individuals[parent2Idx].genes);
+            GeneticParams childGenes = crossover(individuals[ranked[parent1Idx]].genes, 
+                                                 individuals[ranked[parent2Idx]].genes);
             childGenes = mutate(childGenes, mutationRate);
             
             // Create new individual
-            float x = individuals[0].player->getPosition().x;
-            float y = individuals[0].player->getPosition().y;
             string id = generateAlphanumericId();
-            nextGen.emplace_back(id, currentGeneration + 1, childGenes, x, y);
+            addIndividual(nextGen, id, currentGeneration + 1, childGenes, x, y);
         }
         
         individuals = move(nextGen);
+        rankingValid = false;
         currentGeneration++;
+        shareReplay();
         
         cout << "Generation " << currentGeneration << " created with " 
              << eliteCount << " elite individuals" << endl;
     }
     
-    // Get individuals
-    vector<AIIndividual>& getIndividuals() { return individuals; }
+    // Get individuals (population order; non-const access may change
+    // fitness or membership, so the ranking is rebuilt on next use)
+    vector<AIIndividual>& getIndividuals() {
+        rankingValid = false;
+        return individuals;
+    }
     const vector<AIIndividual>& getIndividuals() const { return individuals; }
     
     // Get individual by index
     AIIndividual& getIndividual(int index) { return individuals[index]; }
     const AIIndividual& getIndividual(int index) const { return individuals[index]; }
     
-    // Get best individual
-    AIIndividual& getBest() {
-        sortByFitness();
-        return individuals[0];
-    }
+    // Get best / worst individual
+    AIIndividual& getBest() { return getRanked(0); }
+    const AIIndividual& getBest() const { return getRanked(0); }
+    const AIIndividual& getWorst() const { return getRanked(getSize() - 1); }
     
     // Get population stats
     int getSize() const { return individuals.size(); }
@@ -396,7 +493,7 @@ public:
         file.read(reinterpret_cast<char*>(&currentGeneration), sizeof(currentGeneration));
         file.read(reinterpret_cast<char*>(&nextIdCounter), sizeof(nextIdCounter));
         
-        individuals.clear();
+        retireAll();
         
         // Read individuals
         for (int i = 0; i < populationSize; i++) {
@@ -419,13 +516,14 @@ public:
             file.read(reinterpret_cast<char*>(&totalMatches), sizeof(totalMatches));
             file.read(reinterpret_cast<char*>(&winRate), sizeof(winRate));
             
-            individuals.emplace_back(id, generation, genes, x, y);
+            addIndividual(individuals, id, generation, genes, x, y);
             individuals.back().fitness = fitness;
             individuals.back().wins = wins;
             individuals.back().losses = losses;
             individuals.back().totalMatches = totalMatches;
             individuals.back().winRate = winRate;
         }
+        shareReplay();
         
         file.close();
         cout << "Population loaded from " << filename << endl;
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "AgentState.h"
+#include "MatchPhysics.h"
+#include "QLearningAgent.h"
+#include "Random.h"
+
+using namespace std;
+
+// Glue between the plain-data physics core and the learner: what an agent
+// sees of a MatchPhysicsState and how its decision moves a paddle.
+
+namespace MatchPhysics {
+    // Network input for an AI paddle, normalized to roughly [0, 1]
+    inline AgentState normalizeState(float ballX, float ballY, float ballDirX, float ballDirY,
+                                     float paddleY, float paddleHeight) {
+        AgentState state;
+        state[0] = ballX / 1280.0f;  // Normalized ball X position
+        state[1] = ballY / 720.0f;  // Normalized ball Y position
+        state[2] = (ballDirX + 1.0f) / 2.0f;  // Normalized velocity X (assuming -1 to 1)
+        state[3] = (ballDirY + 1.0f) / 2.0f;  // Normalized velocity Y
+        state[4] = paddleY / 720.0f;  // Normalized paddle Y position
+        state[5] = (paddleY + paddleHeight / 2.0f) / 720.0f;  // Normalized paddle center
+        return state;
+    }
+
+    // Decide (when the reaction delay allows) and move one AI paddle.
+    // Read-only on the agent, so matches on other threads may share it.
+    inline void updateAIPaddle(MatchPhysicsState& state, int side, const PaddleParams& params,
+                               const QLearningAgent& agent, float dt, RandomStream& rng) {
+        PaddleState& paddle = state.paddles[side];
+        paddle.reactionTimer += dt;
+
+        if (paddle.reactionTimer >= params.reactionDelay) {
+            AgentState input = normalizeState(
+                state.ballX, state.ballY,
+                state.ballDirX, state.ballDirY,
+                paddle.y, paddle.height
+            );
+            paddle.lastAction = agent.selectAction(input.data(), rng);
+            paddle.reactionTimer = 0.0f;
+        }
+
+        paddle.y = movePaddleY(paddle.y, paddle.lastAction, params.speed, dt,
+                               paddle.height, state.fieldHeight);
+    }
+}
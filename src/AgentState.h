@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+// Network input with fixed storage, so building one every frame does not
+// touch the heap. Same layout as the vector<float> states.
+struct AgentState {
+    static const int SIZE = 6;
+    float values[SIZE];
+    
+    AgentState() : values() {}
+    
+    float& operator[](int i) { return values[i]; }
+    float operator[](int i) const { return values[i]; }
+    size_t size() const { return SIZE; }
+    const float* data() const { return values; }
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+// std::allocator replacement that aligns every block (default: 32 bytes, one
+// AVX register). Only the start of the block is aligned: rows inside it are
+// aligned only if their owner pads the stride to the alignment, as
+// QuantizedNetwork does. NeuralNetwork packs its float rows, so its kernels
+// must keep using unaligned loads.
+template<typename T, size_t Alignment = 32>
+struct AlignedAllocator {
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() noexcept {}
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+typedef vector<float, AlignedAllocator<float>> AlignedFloats;
@@ -2,10 +2,10 @@
 
 #include <SFML/Graphics.hpp>
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 #include <cmath>
 #include "Utils.h"
+#include "MatchPhysics.h"
+#include "Random.h"
 
 using namespace std;
 
@@ -18,9 +18,11 @@ struct Ball {
     float radius = 20;
     float windowWidth;
     float windowHeight;
+    RandomStream rng;  // Saques de esta pelota
 
     Ball(float windowWidth, float windowHeight) 
-        : windowWidth(windowWidth), windowHeight(windowHeight) {
+        : windowWidth(windowWidth), windowHeight(windowHeight),
+          rng(RandomSeeds::next()) {
         const char* imagePath = "assets/ball.png";
 
         if (!texture.loadFromFile(imagePath)) {
@@ -37,31 +39,14 @@ struct Ball {
         // Centrar en pantalla
         sprite.setPosition(windowWidth / 2 - radius / 2, windowHeight / 2 - radius / 2);
         
-        // Dirección aleatoria hacia un lado con variación angular
-        static bool seeded = false;
-        if (!seeded) {
-            srand(static_cast<unsigned int>(time(nullptr)));
-            seeded = true;
-        }
-        
-        // Generar ángulo aleatorio entre 30 y 60 grados (en radianes)
-        const float MIN_ANGLE = 30.0f * 3.14159f / 180.0f;  // 30 grados en radianes
-        const float MAX_ANGLE = 60.0f * 3.14159f / 180.0f;  // 60 grados en radianes
-        float angleRange = MAX_ANGLE - MIN_ANGLE;
-        float randomAngle = MIN_ANGLE + (rand() / (float)RAND_MAX) * angleRange;
-        
-        // Dirección vertical aleatoria (arriba o abajo)
-        float dirY = (rand() % 2 == 0 ? 1.0f : -1.0f);
-        
-        // Dirección horizontal aleatoria (izquierda o derecha)
-        float dirX = (rand() % 2 == 0 ? 1.0f : -1.0f);
-        
-        // Calcular componentes del vector usando el ángulo
-        dir.x = dirX * cos(randomAngle);
-        dir.y = dirY * sin(randomAngle);
+        // Dirección aleatoria hacia un lado con variación angular:
+        // ángulo entre 30 y 60 grados, dirección vertical y horizontal aleatorias
+        float randomUnit = rng.nextFloat();
+        bool up = rng.nextBool();
+        bool left = rng.nextBool();
         
-        // Normalizar (por seguridad, aunque ya debería estar normalizado)
-        dir = VecUtils::normalized(dir);
+        // Misma fórmula que usa la simulación headless
+        MatchPhysics::serveDirection(randomUnit, up, left, dir.x, dir.y);
     }
 
     void move(float dt, float winWidth, float winHeight) {
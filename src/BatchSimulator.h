@@ -0,0 +1,312 @@
+#pragma once
+
+#include "AgentControl.h"
+#include "PhysicsKernels.h"
+#include "Random.h"
+#include <vector>
+
+using namespace std;
+
+// One side of a batched match: the agent that decides and its paddle geometry
+struct MatchSide {
+    const QLearningAgent* agent;
+    PaddleParams params;
+    float width;
+    float height;
+
+    MatchSide() : agent(nullptr), width(15.0f), height(100.0f) {}
+};
+
+struct BatchMatchJob {
+    int id;  // Caller's identifier (e.g. pairing index)
+    MatchSide sides[2];  // 0 = left, 1 = right
+    RandomStream rng;  // Serves and exploration of this match
+
+    BatchMatchJob() : id(-1) {}
+};
+
+struct BatchMatchOutcome {
+    int id;
+    int scores[2];
+    int frames;      // Fixed steps simulated (stepped modes)
+    int events;      // Events processed (EventDrivenMatch)
+    float duration;  // Simulated seconds
+};
+
+// Lockstep simulator for many independent matches.
+// Lane state is stored as one array per field (structure of arrays) and every
+// step runs the same physics as MatchPhysics::stepBall over all active lanes
+// with the widest PhysicsKernels kernel the CPU supports. Only the agents'
+// decisions, serves and finished-lane bookkeeping are per-lane scalar code.
+// Finished lanes are refilled from the job source or swapped with the last
+// active lane, so the loops always cover [0, activeLanes).
+class BatchSimulator {
+private:
+    int laneCapacity;
+    int activeLanes;
+
+    float fieldWidth;
+    float fieldHeight;
+    float ballSpeed;
+    float ballSize;
+    int winScore;
+    int maxFrames;
+
+    // Ball
+    vector<float> ballX;
+    vector<float> ballY;
+    vector<float> dirX;
+    vector<float> dirY;
+
+    // Paddles, per side
+    vector<float> paddleX[2];
+    vector<float> paddleY[2];
+    vector<float> paddleW[2];
+    vector<float> paddleH[2];
+    vector<float> paddleSpeed[2];
+    vector<float> reactionDelay[2];
+    vector<float> reactionTimer[2];
+    vector<int> action[2];
+    vector<int> score[2];
+    vector<int> lastHit[2];
+    vector<const QLearningAgent*> agent[2];
+
+    // Per-lane bookkeeping
+    vector<int> jobId;
+    vector<int> frames;
+    vector<float> elapsed;
+    vector<int> scorer;  // Scratch: goal detected this step (0, 1 or 2)
+    vector<RandomStream> laneRng;
+    SimdLevel simdLevel;
+    PhysicsKernel kernel;
+
+public:
+    BatchSimulator(int lanes, float width, float height, int winningScore, int frameLimit)
+        : laneCapacity(max(1, lanes)), activeLanes(0),
+          fieldWidth(width), fieldHeight(height), ballSpeed(500.0f), ballSize(20.0f),
+          winScore(winningScore), maxFrames(frameLimit),
+          simdLevel(CpuFeatures::detect()), kernel(PhysicsKernels::get(simdLevel)) {
+        ballX.resize(laneCapacity);
+        ballY.resize(laneCapacity);
+        dirX.resize(laneCapacity);
+        dirY.resize(laneCapacity);
+        for (int s = 0; s < 2; s++) {
+            paddleX[s].resize(laneCapacity);
+            paddleY[s].resize(laneCapacity);
+            paddleW[s].resize(laneCapacity);
+            paddleH[s].resize(laneCapacity);
+            paddleSpeed[s].resize(laneCapacity);
+            reactionDelay[s].resize(laneCapacity);
+            reactionTimer[s].resize(laneCapacity);
+            action[s].resize(laneCapacity);
+            score[s].resize(laneCapacity);
+            lastHit[s].resize(laneCapacity);
+            agent[s].resize(laneCapacity);
+        }
+        jobId.resize(laneCapacity);
+        frames.resize(laneCapacity);
+        elapsed.resize(laneCapacity);
+        scorer.resize(laneCapacity);
+        laneRng.resize(laneCapacity);
+    }
+
+    int getLaneCapacity() const { return laneCapacity; }
+    int getActiveLanes() const { return activeLanes; }
+    SimdLevel getSimdLevel() const { return simdLevel; }
+
+    // Force a narrower physics kernel (e.g. Scalar to compare results)
+    void setSimdLevel(SimdLevel level) {
+        if (level > CpuFeatures::detect()) {
+            level = CpuFeatures::detect();
+        }
+        simdLevel = level;
+        kernel = PhysicsKernels::get(level);
+    }
+
+    // Run jobs until the source is empty and every lane has finished.
+    // nextJob(BatchMatchJob&) returns false when there are no more jobs;
+    // onFinished(const BatchMatchOutcome&) is called once per job.
+    template<typename NextJob, typename OnFinished>
+    void run(float dt, NextJob nextJob, OnFinished onFinished) {
+        run(dt, nextJob, onFinished, []() { return false; });
+    }
+
+    // Same, but abandon() is checked before every step: once it returns true
+    // the run ends and matches still in flight are dropped without an outcome
+    template<typename NextJob, typename OnFinished, typename Abandon>
+    void run(float dt, NextJob nextJob, OnFinished onFinished, Abandon abandon) {
+        bool sourceEmpty = false;
+        activeLanes = 0;
+
+        while (true) {
+            // Fill free lanes
+            while (!sourceEmpty && activeLanes < laneCapacity) {
+                BatchMatchJob job;
+                if (!nextJob(job)) {
+                    sourceEmpty = true;
+                    break;
+                }
+                startLane(activeLanes++, job);
+            }
+
+            if (activeLanes == 0) {
+                break;
+            }
+            if (abandon()) {
+                activeLanes = 0;
+                break;
+            }
+
+            step(dt);
+
+            // Retire finished lanes, refilling or compacting in place
+            for (int lane = 0; lane < activeLanes; ) {
+                if (score[0][lane] < winScore && score[1][lane] < winScore && frames[lane] < maxFrames) {
+                    lane++;
+                    continue;
+                }
+
+                BatchMatchOutcome outcome;
+                outcome.id = jobId[lane];
+                outcome.scores[0] = score[0][lane];
+                outcome.scores[1] = score[1][lane];
+                outcome.frames = frames[lane];
+                outcome.events = 0;
+                outcome.duration = elapsed[lane];
+                onFinished(outcome);
+
+                BatchMatchJob job;
+                if (!sourceEmpty && nextJob(job)) {
+                    startLane(lane, job);
+                    lane++;
+                } else {
+                    sourceEmpty = true;
+                    moveLane(activeLanes - 1, lane);
+                    activeLanes--;
+                }
+            }
+        }
+    }
+
+private:
+    void startLane(int lane, const BatchMatchJob& job) {
+        jobId[lane] = job.id;
+        frames[lane] = 0;
+        elapsed[lane] = 0.0f;
+        laneRng[lane] = job.rng;
+
+        for (int s = 0; s < 2; s++) {
+            const MatchSide& side = job.sides[s];
+            paddleW[s][lane] = side.width;
+            paddleH[s][lane] = side.height;
+            paddleX[s][lane] = (s == 0) ? 35.0f : fieldWidth - 50.0f;
+            paddleY[s][lane] = fieldHeight / 2.0f - side.height / 2.0f;
+            paddleSpeed[s][lane] = side.params.speed;
+            reactionDelay[s][lane] = side.params.reactionDelay;
+            reactionTimer[s][lane] = 0.0f;
+            action[s][lane] = 1;
+            score[s][lane] = 0;
+            lastHit[s][lane] = 0;
+            agent[s][lane] = side.agent;
+        }
+
+        serve(lane);
+    }
+
+    void moveLane(int from, int to) {
+        if (from == to) return;
+        ballX[to] = ballX[from];
+        ballY[to] = ballY[from];
+        dirX[to] = dirX[from];
+        dirY[to] = dirY[from];
+        for (int s = 0; s < 2; s++) {
+            paddleX[s][to] = paddleX[s][from];
+            paddleY[s][to] = paddleY[s][from];
+            paddleW[s][to] = paddleW[s][from];
+            paddleH[s][to] = paddleH[s][from];
+            paddleSpeed[s][to] = paddleSpeed[s][from];
+            reactionDelay[s][to] = reactionDelay[s][from];
+            reactionTimer[s][to] = reactionTimer[s][from];
+            action[s][to] = action[s][from];
+            score[s][to] = score[s][from];
+            lastHit[s][to] = lastHit[s][from];
+            agent[s][to] = agent[s][from];
+        }
+        jobId[to] = jobId[from];
+        frames[to] = frames[from];
+        elapsed[to] = elapsed[from];
+        laneRng[to] = laneRng[from];
+    }
+
+    // Same as MatchPhysics::serveBall for one lane
+    void serve(int lane) {
+        ballX[lane] = fieldWidth / 2 - ballSize / 2;
+        ballY[lane] = fieldHeight / 2 - ballSize / 2;
+
+        RandomStream& rng = laneRng[lane];
+        float randomUnit = rng.nextFloat();
+        bool up = rng.nextBool();
+        bool left = rng.nextBool();
+        MatchPhysics::serveDirection(randomUnit, up, left, dirX[lane], dirY[lane]);
+    }
+
+    void step(float dt) {
+        const int n = activeLanes;
+
+        // Decisions (scalar: every lane has its own network)
+        for (int s = 0; s < 2; s++) {
+            float* timer = reactionTimer[s].data();
+            for (int i = 0; i < n; i++) {
+                timer[i] += dt;
+            }
+            for (int i = 0; i < n; i++) {
+                if (timer[i] >= reactionDelay[s][i]) {
+                    AgentState input = MatchPhysics::normalizeState(
+                        ballX[i], ballY[i], dirX[i], dirY[i],
+                        paddleY[s][i], paddleH[s][i]
+                    );
+                    action[s][i] = agent[s][i]->selectAction(input.data(), laneRng[i]);
+                    timer[i] = 0.0f;
+                }
+            }
+        }
+
+        PhysicsLanes lanes;
+        lanes.count = n;
+        lanes.ballX = ballX.data();
+        lanes.ballY = ballY.data();
+        lanes.dirX = dirX.data();
+        lanes.dirY = dirY.data();
+        for (int s = 0; s < 2; s++) {
+            lanes.paddleX[s] = paddleX[s].data();
+            lanes.paddleY[s] = paddleY[s].data();
+            lanes.paddleW[s] = paddleW[s].data();
+            lanes.paddleH[s] = paddleH[s].data();
+            lanes.paddleSpeed[s] = paddleSpeed[s].data();
+            lanes.action[s] = action[s].data();
+            lanes.lastHit[s] = lastHit[s].data();
+        }
+        lanes.scorer = scorer.data();
+
+        PhysicsParams params;
+        params.fieldWidth = fieldWidth;
+        params.fieldHeight = fieldHeight;
+        params.ballSpeed = ballSpeed;
+        params.ballSize = ballSize;
+        params.dt = dt;
+
+        kernel(lanes, params);
+
+        for (int i = 0; i < n; i++) {
+            frames[i]++;
+            elapsed[i] += dt;
+
+            if (scorer[i] != 0) {
+                score[scorer[i] - 1][i]++;
+                serve(i);
+                lastHit[0][i] = 0;
+                lastHit[1][i] = 0;
+            }
+        }
+    }
+};
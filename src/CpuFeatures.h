@@ -0,0 +1,55 @@
+#pragma once
+
+// Runtime detection of the SIMD instruction sets the hot loops can use.
+// Kernels for wider sets are compiled with per-function target attributes,
+// so the binary still runs on CPUs without them.
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PONG_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define PONG_SIMD_X86 0
+#endif
+
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+namespace CpuFeatures {
+    // Widest instruction set supported by this CPU (detected once)
+    inline SimdLevel detect() {
+        static const SimdLevel level = []() {
+#if PONG_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+            if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+            return SimdLevel::Scalar;
+        }();
+        return level;
+    }
+
+    // Fused multiply-add (shipped with AVX2 on nearly every CPU, but a
+    // separate feature bit)
+    inline bool hasFMA() {
+        static const bool fma = []() {
+#if PONG_SIMD_X86
+            __builtin_cpu_init();
+            return (bool)__builtin_cpu_supports("fma");
+#else
+            return false;
+#endif
+        }();
+        return fma;
+    }
+
+    inline const char* name(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX2: return "AVX2";
+            case SimdLevel::SSE2: return "SSE2";
+            default: return "Scalar";
+        }
+    }
+}
@@ -0,0 +1,296 @@
+#pragma once
+
+#include "CpuFeatures.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+// Inner loops of NeuralNetwork inference: dense layer (z = b + W * x with
+// row-major W), ReLU and softmax. One set per instruction set, picked at
+// runtime. Unlike the physics kernels these are not bit-identical: the SIMD
+// paths sum each dot product in a different order (and the AVX2 one fuses
+// multiply-adds), and softmax uses a polynomial exp accurate to ~1 ulp.
+// The scalar set keeps the exact arithmetic of the original loops.
+
+typedef void (*DenseLayerKernel)(const float* w, const float* b, const float* x,
+                                 int inputSize, int outputSize, float* z);
+typedef void (*ReluKernel)(const float* z, float* out, int size);
+typedef void (*SoftmaxKernel)(const float* x, float* out, int size);
+
+struct DenseKernelSet {
+    SimdLevel level;
+    DenseLayerKernel dense;
+    ReluKernel relu;
+    SoftmaxKernel softmax;
+};
+
+namespace DenseKernels {
+    inline void denseScalar(const float* w, const float* b, const float* x,
+                            int inputSize, int outputSize, float* z) {
+        for (int neuron = 0; neuron < outputSize; neuron++) {
+            const float* row = w + neuron * inputSize;
+            float sum = b[neuron];
+            for (int i = 0; i < inputSize; i++) {
+                sum += x[i] * row[i];
+            }
+            z[neuron] = sum;
+        }
+    }
+
+    inline void reluScalar(const float* z, float* out, int size) {
+        for (int i = 0; i < size; i++) {
+            out[i] = max(0.0f, z[i]);
+        }
+    }
+
+    inline void softmaxScalar(const float* x, float* out, int size) {
+        float maxVal = *max_element(x, x + size);
+        float sum = 0.0f;
+        for (int i = 0; i < size; i++) {
+            out[i] = exp(x[i] - maxVal);  // Subtract max for numerical stability
+            sum += out[i];
+        }
+        for (int i = 0; i < size; i++) {
+            out[i] /= sum;
+        }
+    }
+
+#if PONG_SIMD_X86
+    // Softmax tails shorter than one register are padded with this; exp()
+    // clamps it to ~1e-38, which vanishes next to the max element's 1
+    const float SOFTMAX_PAD = -numeric_limits<float>::infinity();
+
+    // ---- SSE2 ----
+
+    __attribute__((target("sse2")))
+    inline float hsum4(__m128 v) {
+        __m128 high = _mm_movehl_ps(v, v);
+        __m128 pair = _mm_add_ps(v, high);
+        __m128 odd = _mm_shuffle_ps(pair, pair, 0x55);
+        return _mm_cvtss_f32(_mm_add_ss(pair, odd));
+    }
+
+    // exp(x) for x <= 0 (Cephes expf: range reduction by ln 2, degree-5
+    // polynomial, scale by 2^n through the exponent bits)
+    __attribute__((target("sse2")))
+    inline __m128 exp4(__m128 x) {
+        x = _mm_max_ps(x, _mm_set1_ps(-87.3f));
+        __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504f)), _mm_set1_ps(0.5f));
+        // floor(fx): truncate, then step down where truncation rounded up
+        __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+        fx = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, fx), _mm_set1_ps(1.0f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+
+        __m128 y = _mm_set1_ps(1.9875691500e-4f);
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+        y = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(y, x), x), _mm_add_ps(x, _mm_set1_ps(1.0f)));
+
+        __m128i n = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(127)), 23);
+        return _mm_mul_ps(y, _mm_castsi128_ps(n));
+    }
+
+    __attribute__((target("sse2")))
+    inline void denseSSE2(const float* w, const float* b, const float* x,
+                          int inputSize, int outputSize, float* z) {
+        const int vecEnd = inputSize & ~3;
+        for (int neuron = 0; neuron < outputSize; neuron++) {
+            const float* row = w + neuron * inputSize;
+            __m128 acc = _mm_setzero_ps();
+            for (int i = 0; i < vecEnd; i += 4) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(row + i)));
+            }
+            float sum = b[neuron] + hsum4(acc);
+            for (int i = vecEnd; i < inputSize; i++) {
+                sum += x[i] * row[i];
+            }
+            z[neuron] = sum;
+        }
+    }
+
+    __attribute__((target("sse2")))
+    inline void reluSSE2(const float* z, float* out, int size) {
+        const __m128 zero = _mm_setzero_ps();
+        int i = 0;
+        for (; i + 4 <= size; i += 4) {
+            _mm_storeu_ps(out + i, _mm_max_ps(_mm_loadu_ps(z + i), zero));
+        }
+        for (; i < size; i++) {
+            out[i] = max(0.0f, z[i]);
+        }
+    }
+
+    __attribute__((target("sse2")))
+    inline void softmaxSSE2(const float* x, float* out, int size) {
+        float maxVal = *max_element(x, x + size);
+        const __m128 shift = _mm_set1_ps(maxVal);
+        __m128 total = _mm_setzero_ps();
+        int i = 0;
+        for (; i + 4 <= size; i += 4) {
+            __m128 e = exp4(_mm_sub_ps(_mm_loadu_ps(x + i), shift));
+            _mm_storeu_ps(out + i, e);
+            total = _mm_add_ps(total, e);
+        }
+        if (i < size) {
+            float tail[4] = {SOFTMAX_PAD, SOFTMAX_PAD, SOFTMAX_PAD, SOFTMAX_PAD};
+            copy(x + i, x + size, tail);
+            __m128 e = exp4(_mm_sub_ps(_mm_loadu_ps(tail), shift));
+            _mm_storeu_ps(tail, e);
+            copy(tail, tail + (size - i), out + i);
+            total = _mm_add_ps(total, e);
+        }
+        const __m128 scale = _mm_set1_ps(1.0f / hsum4(total));
+        for (i = 0; i + 4 <= size; i += 4) {
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(out + i), scale));
+        }
+        for (; i < size; i++) {
+            out[i] *= _mm_cvtss_f32(scale);
+        }
+    }
+
+    // ---- AVX2 + FMA ----
+
+    // Lane masks for partial loads: maskTail + 8 - n enables the first n lanes
+    alignas(32) static const int maskTail[16] = {
+        -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    __attribute__((target("avx2,fma")))
+    inline __m256 exp8(__m256 x) {
+        x = _mm256_max_ps(x, _mm256_set1_ps(-87.3f));
+        __m256 fx = _mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504f), _mm256_set1_ps(0.5f));
+        fx = _mm256_floor_ps(fx);
+        x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+        x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+
+        __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.3981999507e-3f));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073e-3f));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894e-2f));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459e-1f));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201e-1f));
+        y = _mm256_fmadd_ps(_mm256_mul_ps(y, x), x, _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+
+        __m256i n = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(127)), 23);
+        return _mm256_mul_ps(y, _mm256_castsi256_ps(n));
+    }
+
+    // Dot products of one input against four weight rows, reduced together
+    __attribute__((target("avx2,fma")))
+    inline __m128 dot4Rows(const float* row, const float* x, int inputSize, __m256i tailMask) {
+        const int vecEnd = inputSize & ~7;
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+        int i = 0;
+        for (; i < vecEnd; i += 8) {
+            __m256 xi = _mm256_loadu_ps(x + i);
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(row + i), xi, acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(row + inputSize + i), xi, acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(row + 2 * inputSize + i), xi, acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(row + 3 * inputSize + i), xi, acc3);
+        }
+        if (i < inputSize) {
+            __m256 xi = _mm256_maskload_ps(x + i, tailMask);
+            acc0 = _mm256_fmadd_ps(_mm256_maskload_ps(row + i, tailMask), xi, acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_maskload_ps(row + inputSize + i, tailMask), xi, acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_maskload_ps(row + 2 * inputSize + i, tailMask), xi, acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_maskload_ps(row + 3 * inputSize + i, tailMask), xi, acc3);
+        }
+        __m256 sums = _mm256_hadd_ps(_mm256_hadd_ps(acc0, acc1), _mm256_hadd_ps(acc2, acc3));
+        return _mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1));
+    }
+
+    __attribute__((target("avx2,fma")))
+    inline void denseAVX2(const float* w, const float* b, const float* x,
+                          int inputSize, int outputSize, float* z) {
+        const __m256i tailMask = _mm256_loadu_si256((const __m256i*)(maskTail + 8 - (inputSize & 7)));
+        const int vecEnd = inputSize & ~7;
+        int neuron = 0;
+        for (; neuron + 4 <= outputSize; neuron += 4) {
+            __m128 dots = dot4Rows(w + neuron * inputSize, x, inputSize, tailMask);
+            _mm_storeu_ps(z + neuron, _mm_add_ps(_mm_loadu_ps(b + neuron), dots));
+        }
+        for (; neuron < outputSize; neuron++) {
+            const float* row = w + neuron * inputSize;
+            __m256 acc = _mm256_setzero_ps();
+            int i = 0;
+            for (; i < vecEnd; i += 8) {
+                acc = _mm256_fmadd_ps(_mm256_loadu_ps(row + i), _mm256_loadu_ps(x + i), acc);
+            }
+            if (i < inputSize) {
+                acc = _mm256_fmadd_ps(_mm256_maskload_ps(row + i, tailMask),
+                                      _mm256_maskload_ps(x + i, tailMask), acc);
+            }
+            __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+            z[neuron] = b[neuron] + hsum4(half);
+        }
+    }
+
+    __attribute__((target("avx2,fma")))
+    inline void reluAVX2(const float* z, float* out, int size) {
+        const __m256 zero = _mm256_setzero_ps();
+        int i = 0;
+        for (; i + 8 <= size; i += 8) {
+            _mm256_storeu_ps(out + i, _mm256_max_ps(_mm256_loadu_ps(z + i), zero));
+        }
+        if (i < size) {
+            __m256i mask = _mm256_loadu_si256((const __m256i*)(maskTail + 8 - (size - i)));
+            _mm256_maskstore_ps(out + i, mask, _mm256_max_ps(_mm256_maskload_ps(z + i, mask), zero));
+        }
+    }
+
+    __attribute__((target("avx2,fma")))
+    inline void softmaxAVX2(const float* x, float* out, int size) {
+        float maxVal = *max_element(x, x + size);
+        const __m256 shift = _mm256_set1_ps(maxVal);
+        const __m256 pad = _mm256_set1_ps(SOFTMAX_PAD);
+        __m256 total = _mm256_setzero_ps();
+        int i = 0;
+        for (; i + 8 <= size; i += 8) {
+            __m256 e = exp8(_mm256_sub_ps(_mm256_loadu_ps(x + i), shift));
+            _mm256_storeu_ps(out + i, e);
+            total = _mm256_add_ps(total, e);
+        }
+        __m256i tailMask = _mm256_loadu_si256((const __m256i*)(maskTail + 8 - (size - i)));
+        if (i < size) {
+            __m256 v = _mm256_blendv_ps(pad, _mm256_maskload_ps(x + i, tailMask), _mm256_castsi256_ps(tailMask));
+            __m256 e = exp8(_mm256_sub_ps(v, shift));
+            _mm256_maskstore_ps(out + i, tailMask, e);
+            total = _mm256_add_ps(total, e);
+        }
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(total), _mm256_extractf128_ps(total, 1));
+        const __m256 scale = _mm256_set1_ps(1.0f / hsum4(half));
+        for (i = 0; i + 8 <= size; i += 8) {
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(out + i), scale));
+        }
+        if (i < size) {
+            _mm256_maskstore_ps(out + i, tailMask, _mm256_mul_ps(_mm256_maskload_ps(out + i, tailMask), scale));
+        }
+    }
+#endif
+
+    // Kernel set for an instruction set (AVX2 also needs FMA, otherwise SSE2)
+    inline const DenseKernelSet& get(SimdLevel level) {
+        static const DenseKernelSet scalar = {SimdLevel::Scalar, denseScalar, reluScalar, softmaxScalar};
+#if PONG_SIMD_X86
+        static const DenseKernelSet sse2 = {SimdLevel::SSE2, denseSSE2, reluSSE2, softmaxSSE2};
+        static const DenseKernelSet avx2 = {SimdLevel::AVX2, denseAVX2, reluAVX2, softmaxAVX2};
+        if (level == SimdLevel::AVX2 && CpuFeatures::hasFMA()) return avx2;
+        if (level >= SimdLevel::SSE2) return sse2;
+#endif
+        return scalar;
+    }
+
+    // Widest kernel set this CPU can run
+    inline const DenseKernelSet& best() {
+        return get(CpuFeatures::detect());
+    }
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "AgentControl.h"
+#include "BatchSimulator.h"
+#include <limits>
+
+using namespace std;
+
+// Analytic headless match.
+// Between two events the ball and the paddles move in straight lines, so
+// instead of stepping every frame the match computes in closed form the time
+// of the next event and jumps straight to it. Events are:
+//   - an agent decision (every max(reactionDelay, decisionInterval) seconds)
+//   - a paddle reaching the top or bottom of the field
+//   - the ball reaching a wall
+//   - the ball starting or ending contact with a paddle (swept AABB)
+//   - the ball crossing a goal line
+// Contacts reflect the ball on their first instant, like the rising-edge
+// test of MatchPhysics::stepBall.
+class EventDrivenMatch {
+private:
+    float fieldWidth;
+    float fieldHeight;
+    int winScore;
+    float decisionInterval;  // Shortest time between two decisions of an agent
+    int maxEvents;
+
+public:
+    EventDrivenMatch(float width, float height, int winningScore, float minDecisionInterval, int eventLimit)
+        : fieldWidth(width), fieldHeight(height), winScore(winningScore),
+          decisionInterval(minDecisionInterval), maxEvents(eventLimit) {}
+
+    // Play one match. The outcome reports processed events, not frames.
+    BatchMatchOutcome run(const BatchMatchJob& job) const {
+        const float INF = numeric_limits<float>::infinity();
+
+        RandomStream rng = job.rng;
+        MatchPhysicsState state;
+        state.fieldWidth = fieldWidth;
+        state.fieldHeight = fieldHeight;
+
+        float speed[2];
+        float interval[2];
+        bool decisionDue[2] = {true, true};
+        for (int s = 0; s < 2; s++) {
+            const MatchSide& side = job.sides[s];
+            PaddleState& paddle = state.paddles[s];
+            paddle.width = side.width;
+            paddle.height = side.height;
+            paddle.x = (s == 0) ? 35.0f : fieldWidth - 50.0f;
+            paddle.y = fieldHeight / 2.0f - side.height / 2.0f;
+            speed[s] = side.params.speed;
+            interval[s] = max(side.params.reactionDelay, decisionInterval);
+        }
+        MatchPhysics::serveBall(state, rng);
+
+        double now = 0.0;
+        double nextDecision[2] = {0.0, 0.0};
+        int events = 0;
+
+        while (state.paddles[0].score < winScore &&
+               state.paddles[1].score < winScore &&
+               events < maxEvents) {
+            // Decisions that are due now
+            for (int s = 0; s < 2; s++) {
+                if (!decisionDue[s]) continue;
+                PaddleState& paddle = state.paddles[s];
+                AgentState input = MatchPhysics::normalizeState(
+                    state.ballX, state.ballY, state.ballDirX, state.ballDirY,
+                    paddle.y, paddle.height
+                );
+                paddle.lastAction = job.sides[s].agent->selectAction(input.data(), rng);
+                nextDecision[s] = now + interval[s];
+                decisionDue[s] = false;
+            }
+
+            // Velocities until the next event
+            float paddleVY[2];
+            float tStop[2];
+            float tDecision[2];
+            for (int s = 0; s < 2; s++) {
+                const PaddleState& paddle = state.paddles[s];
+                float v = 0.0f;
+                if (paddle.lastAction == 0 && paddle.y > 0) {
+                    v = -speed[s];
+                } else if (paddle.lastAction == 2 && paddle.y + paddle.height < fieldHeight) {
+                    v = speed[s];
+                }
+                paddleVY[s] = v;
+                tStop[s] = (v < 0) ? paddle.y / -v
+                         : (v > 0) ? (fieldHeight - paddle.height - paddle.y) / v
+                         : INF;
+                tDecision[s] = (float)(nextDecision[s] - now);
+            }
+
+            float vx = state.ballDirX * state.ballSpeed;
+            float vy = state.ballDirY * state.ballSpeed;
+            float size = state.ballSize;
+
+            float tWall = (vy < 0) ? state.ballY / -vy
+                        : (vy > 0) ? (fieldHeight - size - state.ballY) / vy
+                        : INF;
+            float tGoal = (vx < 0) ? (state.ballX + size) / -vx
+                        : (vx > 0) ? (fieldWidth - state.ballX) / vx
+                        : INF;
+
+            float tContact[2];
+            for (int s = 0; s < 2; s++) {
+                const PaddleState& paddle = state.paddles[s];
+                float enter, exit;
+                bool touches = MatchPhysics::sweptOverlap(
+                    state.ballX, state.ballY, size, size, vx, vy,
+                    paddle.x, paddle.y, paddle.width, paddle.height, 0.0f, paddleVY[s],
+                    enter, exit
+                );
+                if (state.lastBallHit[s]) {
+                    tContact[s] = (touches && exit > 0) ? exit : 0.0f;
+                } else {
+                    tContact[s] = (touches && enter >= 0) ? enter : INF;
+                }
+            }
+
+            float t = min(min(tWall, tGoal), min(tContact[0], tContact[1]));
+            t = min(t, min(min(tStop[0], tStop[1]), min(tDecision[0], tDecision[1])));
+            t = max(t, 0.0f);
+
+            // Advance everything to the event
+            state.ballX += vx * t;
+            state.ballY += vy * t;
+            for (int s = 0; s < 2; s++) {
+                state.paddles[s].y += paddleVY[s] * t;
+            }
+            now += t;
+            events++;
+
+            // Apply every event that happens at this instant
+            for (int s = 0; s < 2; s++) {
+                PaddleState& paddle = state.paddles[s];
+                if (tStop[s] <= t) {
+                    paddle.y = (paddleVY[s] < 0) ? 0.0f : fieldHeight - paddle.height;
+                }
+                if (tDecision[s] <= t) {
+                    decisionDue[s] = true;
+                }
+            }
+
+            if (tWall <= t) {
+                state.ballY = (vy < 0) ? 0.0f : fieldHeight - size;
+                state.ballDirY = -state.ballDirY;
+            }
+
+            for (int s = 0; s < 2; s++) {
+                if (tContact[s] <= t) {
+                    if (!state.lastBallHit[s]) {
+                        state.ballDirX *= -1;
+                    }
+                    state.lastBallHit[s] = !state.lastBallHit[s];
+                }
+            }
+
+            if (tGoal <= t) {
+                int scorer = (vx < 0) ? 2 : 1;
+                state.paddles[scorer - 1].score++;
+                MatchPhysics::serveBall(state, rng);
+                state.lastBallHit[0] = false;
+                state.lastBallHit[1] = false;
+            }
+        }
+
+        BatchMatchOutcome outcome;
+        outcome.id = job.id;
+        outcome.scores[0] = state.paddles[0].score;
+        outcome.scores[1] = state.paddles[1].score;
+        outcome.frames = 0;
+        outcome.events = events;
+        outcome.duration = (float)now;
+        return outcome;
+    }
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "NeuralNetwork.h"
+#include <array>
+#include <utility>
+#include <new>
+
+using namespace std;
+
+// Inference-only copy of a one-hidden-layer network whose shape is known at
+// compile time. Storage is std::array, loops have constant trip counts (the
+// compiler unrolls them and keeps the hidden layer in registers) and nothing
+// is allocated. Weights are stored transposed (input-major), which lets the
+// compiler compute several neurons per instruction; each neuron still adds
+// its terms in input order, so results match NeuralNetwork's scalar path.
+template<int In, int Hidden, int Out>
+struct FixedNetwork {
+    alignas(32) array<float, In * Hidden> w1;   // w1[input * Hidden + neuron]
+    alignas(32) array<float, Hidden> b1;
+    alignas(32) array<float, Hidden * Out> w2;  // w2[hidden * Out + output]
+    array<float, Out> b2;
+
+    // Copy from NeuralNetwork's flat layout (row-major weights, then biases)
+    void load(const float* weights, const float* biases) {
+        for (int n = 0; n < Hidden; n++) {
+            for (int i = 0; i < In; i++) {
+                w1[i * Hidden + n] = weights[n * In + i];
+            }
+        }
+        const float* layer2 = weights + In * Hidden;
+        for (int o = 0; o < Out; o++) {
+            for (int n = 0; n < Hidden; n++) {
+                w2[n * Out + o] = layer2[o * Hidden + n];
+            }
+        }
+        for (int n = 0; n < Hidden; n++) {
+            b1[n] = biases[n];
+        }
+        for (int o = 0; o < Out; o++) {
+            b2[o] = biases[Hidden + o];
+        }
+    }
+
+    // Raw Q-values (ReLU hidden layer, linear output)
+    void predict(const float* input, float* q) const {
+        array<float, Hidden> hidden;
+        for (int n = 0; n < Hidden; n++) {
+            float sum = b1[n];
+            for (int i = 0; i < In; i++) {
+                sum += input[i] * w1[i * Hidden + n];
+            }
+            hidden[n] = max(0.0f, sum);
+        }
+
+        array<float, Out> out = b2;
+        for (int n = 0; n < Hidden; n++) {
+            for (int o = 0; o < Out; o++) {
+                out[o] += hidden[n] * w2[n * Out + o];
+            }
+        }
+        for (int o = 0; o < Out; o++) {
+            q[o] = out[o];
+        }
+    }
+};
+
+// The agent's Q-network as a FixedNetwork, for every hidden size the genetic
+// algorithm can produce (GeneticParams::hiddenLayerSize, 8 - 24). The
+// instantiation is picked from a dispatch table when the agent is built (or
+// its shape changes); other shapes are not supported and the caller falls
+// back to the generic NeuralNetwork.
+class FixedPolicy {
+public:
+    static const int INPUTS = 6;
+    static const int OUTPUTS = 3;
+    static const int MIN_HIDDEN = 8;
+    static const int MAX_HIDDEN = 24;
+
+private:
+    typedef FixedNetwork<INPUTS, MAX_HIDDEN, OUTPUTS> LargestNetwork;
+
+    struct Ops {
+        void (*load)(void* net, const float* weights, const float* biases);
+        void (*predict)(const void* net, const float* input, float* q);
+    };
+
+    template<int Hidden>
+    static void loadAs(void* net, const float* weights, const float* biases) {
+        (new (net) FixedNetwork<INPUTS, Hidden, OUTPUTS>())->load(weights, biases);
+    }
+
+    template<int Hidden>
+    static void predictAs(const void* net, const float* input, float* q) {
+        static_cast<const FixedNetwork<INPUTS, Hidden, OUTPUTS>*>(net)->predict(input, q);
+    }
+
+    template<int... Offsets>
+    static const Ops* makeTable(integer_sequence<int, Offsets...>) {
+        static const Ops table[] = {
+            { loadAs<MIN_HIDDEN + Offsets>, predictAs<MIN_HIDDEN + Offsets> }...
+        };
+        return table;
+    }
+
+    static const Ops* dispatchTable() {
+        return makeTable(make_integer_sequence<int, MAX_HIDDEN - MIN_HIDDEN + 1>());
+    }
+
+    alignas(32) unsigned char storage[sizeof(LargestNetwork)];
+    const Ops* ops;            // nullptr when the shape is not supported
+    unsigned long version;     // NeuralNetwork version the storage was loaded from
+
+public:
+    FixedPolicy() : ops(nullptr), version(0) {}
+
+    static bool supports(const vector<int>& layerSizes) {
+        return layerSizes.size() == 3 &&
+               layerSizes[0] == INPUTS && layerSizes[2] == OUTPUTS &&
+               layerSizes[1] >= MIN_HIDDEN && layerSizes[1] <= MAX_HIDDEN;
+    }
+
+    // Pick the instantiation for network's shape and copy its parameters
+    void bind(const NeuralNetwork& network) {
+        const vector<int>& sizes = network.getLayerSizes();
+        version = network.getVersion();
+        if (!supports(sizes)) {
+            ops = nullptr;
+            return;
+        }
+        ops = &dispatchTable()[sizes[1] - MIN_HIDDEN];
+        ops->load(storage, network.weightData(), network.biasData());
+    }
+
+    // True when the fixed copy can stand in for network right now
+    bool isCurrent(const NeuralNetwork& network) const {
+        return ops != nullptr && version == network.getVersion();
+    }
+
+    void predict(const float* input, float* q) const {
+        ops->predict(storage, input, q);
+    }
+};
@@ -66,11 +66,13 @@ struct Game {
 	// Game state tracking
 	bool lastBallHitPlayer = false;
 	bool lastBallHitOpponent = false;
-	vector<float> lastOpponentState;
+	AgentState lastOpponentState;
 	
 	// Options state
 	DifficultyLevel currentDifficulty = DifficultyLevel::Medium;
 	bool trainingMode = true;
+	bool quantizedOpponent = false;  // Opponent plays with its int8 network while not training
+	bool prioritizedReplay = false;  // Opponent replays high-TD-error transitions more often
 	
 	// Tournament configuration state
 	int tournamentPopulationSize = 16;
@@ -102,6 +104,8 @@ struct Game {
 
 		ball = new Ball(width, height);
 		opponent = new AIPlayer(width - 50, height / 2, 15, 100, currentDifficulty);
+		opponent->getAgent().setQuantizedInference(quantizedOpponent);
+		opponent->getAgent().setPrioritizedReplay(prioritizedReplay);
 		
 		// Try to load top 1 from tournament first, then fallback to regular model
 		if (opponent) {
@@ -448,7 +452,8 @@ struct Game {
 						if (opt == "Start Tournament") {
 							if (tournamentManager) {
 								tournamentManager->initialize();
-								tournamentManager->start();
+								if (hudDisplay) hudDisplay->resetTournamentTelemetry(tournamentManager->getTelemetry());
+								tournamentManager->startBackground();
 								state = GameState::Tournament;
 							}
 						}
@@ -461,6 +466,7 @@ struct Game {
 							cout << "Tournament statistics (coming soon)" << endl;
 						}
 						else if (opt == "Watch Top Match") {
+							if (tournamentManager) tournamentManager->stopBackground();
 							if (tournamentManager && tournamentManager->getPopulation()->getSize() >= 2) {
 								tournamentManager->watchMatch(0, 1);
 							}
@@ -582,14 +588,17 @@ struct Game {
 					// Handle tournament controls
 					if (event.type == sf::Event::KeyPressed) {
 						if (event.key.code == sf::Keyboard::Escape) {
+							// The tournament thread stops after its current matches
+							tournamentManager->post(TournamentCommand::Stop);
 							state = GameState::TournamentMenu;
 						}
 						else if (event.key.code == sf::Keyboard::Space) {
 							// Pause/Resume
-							if (tournamentManager->getState() == TournamentState::Running) {
-								tournamentManager->pause();
-							} else if (tournamentManager->getState() == TournamentState::Paused) {
-								tournamentManager->resume();
+							TournamentState shown = tournamentManager->readSnapshot().state;
+							if (shown == TournamentState::Running) {
+								tournamentManager->post(TournamentCommand::Pause);
+							} else if (shown == TournamentState::Paused) {
+								tournamentManager->post(TournamentCommand::Resume);
 							}
 						}
 					}
@@ -630,7 +639,7 @@ struct Game {
 		if (currentBallHitOpponent && !lastBallHitOpponent) {
 		    ball->dir.x *= -1;
 		    // Record experience for opponent (ball was hit by opponent)
-		    vector<float> currentState = opponent->getCurrentState(*ball, height);
+		    AgentState currentState = opponent->getCurrentState(*ball, height);
 		    opponent->recordExperience(true, false, false, false, currentState);
 		}
 
@@ -756,7 +765,7 @@ struct Game {
 		}
 		lastBallHitPlayer = false;
 		lastBallHitOpponent = false;
-		lastOpponentState.clear();
+		lastOpponentState = AgentState();
 		state = GameState::Playing;
 	}
 	
@@ -857,14 +866,10 @@ struct Game {
 	void updateTournament(float dt) {
 		if (!tournamentManager) return;
 		
-		if (tournamentManager->getState() == TournamentState::Running) {
-			// Run one generation per update cycle
-			bool hasMore = tournamentManager->runGeneration();
-			
-			if (!hasMore) {
-				tournamentManager->stop();
-				state = GameState::TournamentMenu;
-			}
+		// Generations run on the tournament thread; back to the menu once it finishes
+		if (!tournamentManager->isBackgroundRunning()) {
+			tournamentManager->stopBackground();
+			state = GameState::TournamentMenu;
 		}
 	}
 
@@ -1015,31 +1020,33 @@ struct Game {
 		// Dark background
 		window.clear(sf::Color(10, 10, 20));
 		
-		// Render tournament stats
+		// Render tournament stats (published by the tournament thread)
 		if (hudDisplay) {
+			const TournamentSnapshot& snapshot = tournamentManager->readSnapshot();
+			const IndividualSummary* champion = snapshot.hasChampion ? &snapshot.champion : nullptr;
+			
 			hudDisplay->renderTournamentStats(
 				window,
-				tournamentManager->getCurrentGeneration(),
-				tournamentManager->getMaxGenerations(),
-				tournamentManager->getProgress(),
-				tournamentManager->getStatusMessage(),
-				tournamentManager->getCurrentAverageFitness(),  // Use current instead of last
-				tournamentManager->getLastBestFitness(),
-				tournamentManager->getAllTimeBestFitness(),
-				tournamentManager->getAllTimeBestIndividual(),
-				tournamentManager->getFormattedETA()  // Add ETA
+				snapshot.currentGeneration,
+				snapshot.maxGenerations,
+				snapshot.progress,
+				snapshot.statusMessage,
+				snapshot.avgFitness,
+				snapshot.bestFitness,
+				snapshot.allTimeBestFitness,
+				champion,
+				snapshot.eta,
+				tournamentManager->getTelemetry(),
+				snapshot.remainingMatches()
 			);
 			
 			// Render top individuals
-			auto topIndividuals = tournamentManager->getTopIndividuals(5);
-			string championId = "";
-			if (tournamentManager->hasAllTimeRecord()) {
-				const AIIndividual* champion = tournamentManager->getAllTimeBestIndividual();
-				if (champion) {
-					championId = champion->id;
-				}
+			vector<const IndividualSummary*> topIndividuals;
+			for (const auto& summary : snapshot.top) {
+				topIndividuals.push_back(&summary);
 			}
-			hudDisplay->renderTopIndividuals(window, topIndividuals, 5, championId);
+			string championId = champion ? champion->id : "";
+			hudDisplay->renderTopIndividuals(window, topIndividuals, TournamentSnapshot::TOP_COUNT, championId);
 		}
 		
 		// Controls hint
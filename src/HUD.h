@@ -5,6 +5,7 @@
 #include <cstdio>
 #include <vector>
 #include "AIPopulation.h"
+#include "MatchTelemetry.h"
 
 using namespace std;
 
@@ -20,6 +21,9 @@ struct HUD {
 	float fps = 0.0f;
 	int windowWidth = 0;
 	int windowHeight = 0;
+	
+	// Throughput of the running tournament, from its match events
+	MatchTelemetryRates tournamentRates;
 
 	HUD(sf::Font* f, int width) {
 		font = f;
@@ -79,6 +83,7 @@ struct HUD {
 	}
 	
 	// Render tournament statistics
+	template<typename T>
 	void renderTournamentStats(sf::RenderWindow& window, 
 	                           int currentGen, int maxGen, 
 	                           float progress, 
@@ -86,8 +91,12 @@ struct HUD {
 	                           float avgFitness, 
 	                           float bestFitness,
 	                           float allTimeBestFitness,
-	                           const AIIndividual* champion,
-	                           const string& eta) {
+	                           const T* champion,
+	                           const string& eta,
+	                           MatchTelemetryFeed& telemetry,
+	                           int remainingMatches) {
+		renderTournamentTelemetry(window, telemetry, remainingMatches);
+		
 		float startY = 30;
 		float lineHeight = 25;
 		
@@ -217,6 +226,70 @@ struct HUD {
 		}
 	}
 	
+	// Forget the previous tournament's events and rates
+	void resetTournamentTelemetry(MatchTelemetryFeed& telemetry) {
+		telemetry.drain([](const MatchTelemetry&) {});
+		tournamentRates.reset();
+	}
+	
+	// Live throughput below the ranking: drains the match events queued
+	// since the last frame
+	void renderTournamentTelemetry(sf::RenderWindow& window, MatchTelemetryFeed& telemetry,
+	                               int remainingMatches) {
+		tournamentRates.update(telemetry);
+		float startY = 530;
+		
+		char etaStr[32] = "--";
+		float etaSeconds = tournamentRates.etaSeconds(remainingMatches);
+		if (remainingMatches == 0) {
+			snprintf(etaStr, sizeof(etaStr), "-");
+		} else if (etaSeconds >= 0.0f) {
+			int total = (int)etaSeconds;
+			if (total >= 3600) {
+				snprintf(etaStr, sizeof(etaStr), "%dh %dm", total / 3600, (total % 3600) / 60);
+			} else if (total >= 60) {
+				snprintf(etaStr, sizeof(etaStr), "%dm %ds", total / 60, total % 60);
+			} else {
+				snprintf(etaStr, sizeof(etaStr), "%ds", total);
+			}
+		}
+		
+		sf::Text rateText;
+		rateText.setFont(*font);
+		rateText.setCharacterSize(18);
+		rateText.setFillColor(sf::Color(150, 200, 255));
+		// Event-driven matches count events, not frames
+		float eventRate = tournamentRates.eventsPerSecond();
+		bool eventDriven = eventRate > 0.0f;
+		char rateStr[160];
+		snprintf(rateStr, sizeof(rateStr),
+		         "%.1f matches/s  |  %.0f %s/s  |  %.0f ms/match  |  ETA (%d matches): %s",
+		         tournamentRates.matchesPerSecond(),
+		         eventDriven ? eventRate : tournamentRates.framesPerSecond(),
+		         eventDriven ? "events" : "frames",
+		         tournamentRates.averageMatchWallTime() * 1000.0f, remainingMatches, etaStr);
+		rateText.setString(rateStr);
+		rateText.setPosition(windowWidth / 2 - rateText.getLocalBounds().width / 2, startY);
+		window.draw(rateText);
+		
+		const MatchTelemetry* last = tournamentRates.getLastMatch();
+		if (last) {
+			sf::Text lastText;
+			lastText.setFont(*font);
+			lastText.setCharacterSize(16);
+			lastText.setFillColor(sf::Color(150, 150, 150));
+			char lastStr[128];
+			snprintf(lastStr, sizeof(lastStr),
+			         "Last: %s %d - %d %s  (%d %s, %.1f s simulated)",
+			         last->homeId, last->homeScore, last->awayScore, last->awayId,
+			         last->events > 0 ? last->events : last->frames,
+			         last->events > 0 ? "events" : "frames", last->simTime);
+			lastText.setString(lastStr);
+			lastText.setPosition(windowWidth / 2 - lastText.getLocalBounds().width / 2, startY + 25);
+			window.draw(lastText);
+		}
+	}
+	
 	// Render top individuals ranking  
 	template<typename T>
 	void renderTopIndividuals(sf::RenderWindow& window, 
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+// Bounded single-producer / single-consumer queue. push() is called from one
+// thread only and pop() from one other thread only; neither blocks or
+// allocates. Capacity must be a power of two.
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+private:
+    T items[Capacity];
+    alignas(64) atomic<size_t> head;  // Next slot to read (consumer)
+    alignas(64) atomic<size_t> tail;  // Next slot to write (producer)
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Producer: false (and nothing queued) when full
+    bool push(const T& item) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - head.load(memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    // Consumer: false when empty
+    bool pop(T& item) {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == tail.load(memory_order_acquire)) {
+            return false;
+        }
+        item = items[h & (Capacity - 1)];
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head.load(memory_order_acquire) == tail.load(memory_order_acquire);
+    }
+};
+
+// Latest-value channel from one writer thread to one reader thread. The
+// writer fills back() and publish()es it; the reader gets the newest
+// published value from read(). Three slots, so neither side ever waits and
+// values with heap storage (strings, vectors) are safe: each slot belongs to
+// exactly one side at a time and keeps its capacity between uses.
+template<typename T>
+class TripleBuffer {
+private:
+    static const int INDEX_MASK = 3;
+    static const int FRESH = 4;  // Set in middle when it holds an unread value
+
+    T slots[3];
+    int backIndex;              // Writer's slot
+    alignas(64) atomic<int> middle;
+    alignas(64) int frontIndex; // Reader's slot
+
+public:
+    TripleBuffer() : backIndex(0), middle(1), frontIndex(2) {}
+
+    // Writer: slot to fill (holds an older value)
+    T& back() { return slots[backIndex]; }
+
+    // Writer: hand back() to the reader
+    void publish() {
+        backIndex = middle.exchange(backIndex | FRESH, memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Reader: newest published value (the previous one if nothing new)
+    const T& read() {
+        if (middle.load(memory_order_relaxed) & FRESH) {
+            frontIndex = middle.exchange(frontIndex, memory_order_acq_rel) & INDEX_MASK;
+        }
+        return slots[frontIndex];
+    }
+};
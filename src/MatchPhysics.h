@@ -0,0 +1,204 @@
+#pragma once
+
+#include "Random.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+// Plain-data Pong simulation used by headless tournament matches.
+// Nothing in here depends on SFML: the visual path copies this state into
+// sprites and shapes only when it needs to draw it.
+
+// Paddle as seen by the simulation: its rectangle plus the AI controller state
+struct PaddleState {
+    float x;
+    float y;
+    float width;
+    float height;
+    float reactionTimer;
+    int lastAction;
+    int score;
+
+    PaddleState()
+        : x(0.0f), y(0.0f), width(15.0f), height(100.0f),
+          reactionTimer(0.0f), lastAction(1), score(0) {}
+};
+
+// Movement parameters of an AI paddle (taken from its AIPlayer at setup)
+struct PaddleParams {
+    float speed;
+    float reactionDelay;
+
+    PaddleParams() : speed(300.0f), reactionDelay(0.1f) {}
+    PaddleParams(float s, float delay) : speed(s), reactionDelay(delay) {}
+};
+
+struct MatchPhysicsState {
+    float fieldWidth;
+    float fieldHeight;
+
+    // Ball (position is the top-left corner, like Ball's sprite)
+    float ballX;
+    float ballY;
+    float ballDirX;
+    float ballDirY;
+    float ballSpeed;
+    float ballSize;
+
+    PaddleState paddles[2];  // 0 = left, 1 = right
+    bool lastBallHit[2];
+
+    MatchPhysicsState()
+        : fieldWidth(1280.0f), fieldHeight(720.0f),
+          ballX(0.0f), ballY(0.0f), ballDirX(1.0f), ballDirY(1.0f),
+          ballSpeed(500.0f), ballSize(20.0f) {
+        lastBallHit[0] = false;
+        lastBallHit[1] = false;
+    }
+};
+
+namespace MatchPhysics {
+    // Same test as sf::FloatRect::intersects
+    inline bool overlap(float ax, float ay, float aw, float ah,
+                        float bx, float by, float bw, float bh) {
+        float left = max(ax, bx);
+        float top = max(ay, by);
+        float right = min(ax + aw, bx + bw);
+        float bottom = min(ay + ah, by + bh);
+        return left < right && top < bottom;
+    }
+
+    // Narrow [tEnter, tExit] to the times at which two segments moving with
+    // relative velocity v overlap on one axis (strict, like overlap)
+    inline bool sweptAxis(float a, float aSize, float b, float bSize, float v,
+                          float& tEnter, float& tExit) {
+        if (v == 0) {
+            return a < b + bSize && b < a + aSize;
+        }
+        float t0 = (b - aSize - a) / v;  // a + aSize reaches b
+        float t1 = (b + bSize - a) / v;  // a reaches b + bSize
+        if (t0 > t1) {
+            swap(t0, t1);
+        }
+        tEnter = max(tEnter, t0);
+        tExit = min(tExit, t1);
+        return true;
+    }
+
+    // Time interval during which two boxes with constant velocities overlap.
+    // Returns false if they never do; tEnter may be negative if they already overlap.
+    inline bool sweptOverlap(float ax, float ay, float aw, float ah, float avx, float avy,
+                             float bx, float by, float bw, float bh, float bvx, float bvy,
+                             float& tEnter, float& tExit) {
+        tEnter = -numeric_limits<float>::infinity();
+        tExit = numeric_limits<float>::infinity();
+        if (!sweptAxis(ax, aw, bx, bw, avx - bvx, tEnter, tExit)) return false;
+        if (!sweptAxis(ay, ah, by, bh, avy - bvy, tEnter, tExit)) return false;
+        return tEnter < tExit;
+    }
+
+    // Serve direction: angle between 30 and 60 degrees, randomUnit in [0, 1]
+    inline void serveDirection(float randomUnit, bool up, bool left, float& dirX, float& dirY) {
+        const float MIN_ANGLE = 30.0f * 3.14159f / 180.0f;
+        const float MAX_ANGLE = 60.0f * 3.14159f / 180.0f;
+        float angle = MIN_ANGLE + randomUnit * (MAX_ANGLE - MIN_ANGLE);
+
+        float x = (left ? -1.0f : 1.0f) * cos(angle);
+        float y = (up ? -1.0f : 1.0f) * sin(angle);
+
+        float mag = sqrt(x * x + y * y);
+        dirX = mag != 0 ? x / mag : 0.0f;
+        dirY = mag != 0 ? y / mag : 0.0f;
+    }
+
+    // Center the ball and pick a random serve direction
+    inline void serveBall(MatchPhysicsState& state, RandomStream& rng) {
+        state.ballX = state.fieldWidth / 2 - state.ballSize / 2;
+        state.ballY = state.fieldHeight / 2 - state.ballSize / 2;
+
+        float randomUnit = rng.nextFloat();
+        bool up = rng.nextBool();
+        bool left = rng.nextBool();
+        serveDirection(randomUnit, up, left, state.ballDirX, state.ballDirY);
+    }
+
+    // Paddle Y after applying an action (0 = up, 1 = stay, 2 = down) for dt seconds
+    inline float movePaddleY(float y, int action, float speed, float dt,
+                             float paddleHeight, float fieldHeight) {
+        if (action == 0) {
+            y -= speed * dt;
+            if (y < 0) {
+                y = 0;
+            }
+        } else if (action == 2) {
+            y += speed * dt;
+            if (y + paddleHeight > fieldHeight) {
+                y = fieldHeight - paddleHeight;
+            }
+        }
+        return y;
+    }
+
+    // Advance the ball by dt: move, bounce on walls and paddles, detect goals.
+    // Returns 0 while in play, 1 if the left paddle scored, 2 if the right one did.
+    // On a goal the score is updated and the ball is served again.
+    inline int stepBall(MatchPhysicsState& state, float dt, RandomStream& rng) {
+        float startX = state.ballX;
+        float startY = state.ballY;
+        float vx = state.ballDirX * state.ballSpeed;
+        float vy = state.ballDirY * state.ballSpeed;
+
+        // Move (same as Ball::move)
+        state.ballX += vx * dt;
+        state.ballY += vy * dt;
+
+        // Bounce on top/bottom walls
+        if (state.ballY < 0) {
+            state.ballY = 0;
+            state.ballDirY = -state.ballDirY;
+        } else if (state.ballY + state.ballSize > state.fieldHeight) {
+            state.ballY = state.fieldHeight - state.ballSize;
+            state.ballDirY = -state.ballDirY;
+        }
+
+        // Paddle collisions, reflected only on the step contact starts.
+        // The test is swept over the whole step, so a fast ball cannot pass
+        // through a paddle between two steps; on impact the ball is reflected
+        // at the contact point and travels back for the rest of the step.
+        for (int side = 0; side < 2; side++) {
+            const PaddleState& paddle = state.paddles[side];
+            float enter, exit;
+            bool touches = sweptOverlap(startX, startY, state.ballSize, state.ballSize, vx, vy,
+                                        paddle.x, paddle.y, paddle.width, paddle.height, 0.0f, 0.0f,
+                                        enter, exit);
+            bool hit = touches && enter < dt && exit > 0;
+            if (hit && !state.lastBallHit[side]) {
+                float impact = max(enter, 0.0f);
+                state.ballDirX *= -1;
+                state.ballX = (startX + vx * impact) - vx * (dt - impact);
+            }
+            state.lastBallHit[side] = hit;
+        }
+
+        // Goals (same as Ball::checkScore)
+        int scorer = 0;
+        if (state.ballX < -state.ballSize) {
+            scorer = 2;
+        } else if (state.ballX > state.fieldWidth) {
+            scorer = 1;
+        }
+
+        if (scorer != 0) {
+            state.paddles[scorer - 1].score++;
+            serveBall(state, rng);
+            state.lastBallHit[0] = false;
+            state.lastBallHit[1] = false;
+        }
+
+        return scorer;
+    }
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "LockFree.h"
+#include <vector>
+#include <deque>
+#include <memory>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+// One finished tournament match, as reported by the worker that played it.
+// Plain data so it can sit in a lock-free ring.
+struct MatchTelemetry {
+    int generation;
+    int pairing;
+    char homeId[8];
+    char awayId[8];
+    int homeScore;
+    int awayScore;
+    int frames;      // Fixed steps simulated (stepped modes)
+    int events;      // Events processed (event-driven mode)
+    float simTime;   // Simulated seconds
+    float wallTime;  // Real seconds from claiming the pairing to its result
+
+    MatchTelemetry()
+        : generation(0), pairing(0), homeScore(0), awayScore(0), frames(0), events(0),
+          simTime(0.0f), wallTime(0.0f) {
+        homeId[0] = '\0';
+        awayId[0] = '\0';
+    }
+
+    void setIds(const string& home, const string& away) {
+        strncpy(homeId, home.c_str(), sizeof(homeId) - 1);
+        homeId[sizeof(homeId) - 1] = '\0';
+        strncpy(awayId, away.c_str(), sizeof(awayId) - 1);
+        awayId[sizeof(awayId) - 1] = '\0';
+    }
+};
+
+// Match events from the tournament workers to the render loop: one SPSC ring
+// per worker, so every ring has a single producer. Events that find their
+// ring full are dropped (counted) rather than slowing a worker down.
+class MatchTelemetryFeed {
+public:
+    static const size_t RING_CAPACITY = 1024;
+
+private:
+    typedef SpscQueue<MatchTelemetry, RING_CAPACITY> Ring;
+
+    vector<unique_ptr<Ring>> rings;
+    atomic<long> dropped;
+
+public:
+    MatchTelemetryFeed() : dropped(0) {}
+
+    // Ring count; only while no worker is running and nobody drains
+    void setWorkerCount(int workers) {
+        rings.clear();
+        for (int w = 0; w < workers; w++) {
+            rings.emplace_back(new Ring());
+        }
+    }
+
+    int getWorkerCount() const {
+        return rings.size();
+    }
+
+    // Producer side: called by worker `worker` only
+    void push(int worker, const MatchTelemetry& event) {
+        if (worker >= (int)rings.size() || !rings[worker]->push(event)) {
+            dropped++;
+        }
+    }
+
+    // Consumer side (one thread): hand every queued event to visit; returns
+    // how many there were
+    template<typename Visitor>
+    int drain(Visitor visit) {
+        int count = 0;
+        MatchTelemetry event;
+        for (auto& ring : rings) {
+            while (ring->pop(event)) {
+                visit(event);
+                count++;
+            }
+        }
+        return count;
+    }
+
+    long getDropped() const {
+        return dropped;
+    }
+};
+
+// Live throughput over the last WINDOW_SECONDS of drained match events
+class MatchTelemetryRates {
+public:
+    static constexpr float WINDOW_SECONDS = 2.0f;
+    static constexpr float MIN_WINDOW_SECONDS = 0.5f;  // Steadies the first rates
+
+private:
+    struct Sample {
+        float time;
+        int matches;
+        long frames;
+        long events;
+        float wallTime;
+        float simTime;
+    };
+
+    chrono::steady_clock::time_point origin;
+    deque<Sample> samples;  // One per drain that found events
+    float firstEventTime;   // Of the current stream of events
+    MatchTelemetry lastMatch;
+    bool hasLastMatch;
+
+    float now() const {
+        return chrono::duration<float>(chrono::steady_clock::now() - origin).count();
+    }
+
+public:
+    MatchTelemetryRates() : origin(chrono::steady_clock::now()), firstEventTime(0.0f), hasLastMatch(false) {}
+
+    void reset() {
+        samples.clear();
+        hasLastMatch = false;
+        origin = chrono::steady_clock::now();
+    }
+
+    // Take every event queued in feed (call once per rendered frame)
+    void update(MatchTelemetryFeed& feed) {
+        Sample sample = { now(), 0, 0, 0, 0.0f, 0.0f };
+        feed.drain([&](const MatchTelemetry& event) {
+            sample.matches++;
+            sample.frames += event.frames;
+            sample.events += event.events;
+            sample.wallTime += event.wallTime;
+            sample.simTime += event.simTime;
+            lastMatch = event;
+            hasLastMatch = true;
+        });
+        if (sample.matches > 0) {
+            if (samples.empty()) {
+                firstEventTime = sample.time;
+            }
+            samples.push_back(sample);
+        }
+        while (!samples.empty() && samples.front().time < sample.time - WINDOW_SECONDS) {
+            samples.pop_front();
+        }
+    }
+
+    // Seconds covered by the window (shorter right after the first events)
+    float windowLength() const {
+        if (samples.empty()) return 0.0f;
+        return min(WINDOW_SECONDS, max(now() - firstEventTime, MIN_WINDOW_SECONDS));
+    }
+
+    float matchesPerSecond() const {
+        float length = windowLength();
+        if (length <= 0.0f) return 0.0f;
+        int matches = 0;
+        for (const auto& s : samples) matches += s.matches;
+        return matches / length;
+    }
+
+    float framesPerSecond() const {
+        float length = windowLength();
+        if (length <= 0.0f) return 0.0f;
+        long frames = 0;
+        for (const auto& s : samples) frames += s.frames;
+        return frames / length;
+    }
+
+    // Same for event-driven matches, which report events instead of frames
+    float eventsPerSecond() const {
+        float length = windowLength();
+        if (length <= 0.0f) return 0.0f;
+        long events = 0;
+        for (const auto& s : samples) events += s.events;
+        return events / length;
+    }
+
+    // Mean wall-clock seconds a match took in the window (workers overlap)
+    float averageMatchWallTime() const {
+        int matches = 0;
+        float wall = 0.0f;
+        for (const auto& s : samples) {
+            matches += s.matches;
+            wall += s.wallTime;
+        }
+        return matches > 0 ? wall / matches : 0.0f;
+    }
+
+    // Seconds until remainingMatches are played at the current rate (-1 = unknown)
+    float etaSeconds(int remainingMatches) const {
+        float rate = matchesPerSecond();
+        return rate > 0.0f ? remainingMatches / rate : -1.0f;
+    }
+
+    const MatchTelemetry* getLastMatch() const {
+        return hasLastMatch ? &lastMatch : nullptr;
+    }
+};
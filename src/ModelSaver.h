@@ -19,41 +19,19 @@ public:
             return false;
         }
 
-        vector<vector<vector<float>>> weights = network.getWeights();
-        vector<vector<float>> biases = network.getBiases();
+        const vector<int>& layerSizes = network.getLayerSizes();
 
         // Write number of layers
-        int numLayers = weights.size();
+        int numLayers = layerSizes.size() - 1;
         file.write(reinterpret_cast<const char*>(&numLayers), sizeof(int));
 
-        // Write layer sizes (inferred from weights)
-        // First layer input size
-        int firstInputSize = weights[0][0].size();
-        file.write(reinterpret_cast<const char*>(&firstInputSize), sizeof(int));
-        
-        // Then output size for each layer
-        for (int layer = 0; layer < numLayers; layer++) {
-            int outputSize = weights[layer].size();
-            file.write(reinterpret_cast<const char*>(&outputSize), sizeof(int));
-        }
+        // Write layer sizes: first layer input size, then output size for each layer
+        file.write(reinterpret_cast<const char*>(layerSizes.data()), (numLayers + 1) * sizeof(int));
 
-        // Write weights
-        for (int layer = 0; layer < numLayers; layer++) {
-            for (size_t neuron = 0; neuron < weights[layer].size(); neuron++) {
-                for (size_t input = 0; input < weights[layer][neuron].size(); input++) {
-                    float weight = weights[layer][neuron][input];
-                    file.write(reinterpret_cast<const char*>(&weight), sizeof(float));
-                }
-            }
-        }
-
-        // Write biases
-        for (int layer = 0; layer < numLayers; layer++) {
-            for (size_t neuron = 0; neuron < biases[layer].size(); neuron++) {
-                float bias = biases[layer][neuron];
-                file.write(reinterpret_cast<const char*>(&bias), sizeof(float));
-            }
-        }
+        // Weights (layer, neuron, input) and biases (layer, neuron) are
+        // already stored contiguously in file order
+        file.write(reinterpret_cast<const char*>(network.weightData()), network.weightCount() * sizeof(float));
+        file.write(reinterpret_cast<const char*>(network.biasData()), network.biasCount() * sizeof(float));
 
         file.close();
         cout << "Modelo guardado exitosamente en: " << filename << endl;
@@ -144,45 +122,19 @@ public:
             layerSizes.push_back(outputSize);
         }
 
-        // Reconstruct network architecture
-        // Note: This assumes the network structure matches
-        // For a more robust solution, we'd need to store the full architecture
+        // Adopt the stored architecture and read the parameters in place
+        network.setLayerSizes(layerSizes);
+        file.read(reinterpret_cast<char*>(network.weightData()), network.weightCount() * sizeof(float));
+        file.read(reinterpret_cast<char*>(network.biasData()), network.biasCount() * sizeof(float));
 
-        // Read weights
-        vector<vector<vector<float>>> weights(numLayers);
-        for (int layer = 0; layer < numLayers; layer++) {
-            int outputSize = layerSizes[layer + 1];
-            int inputSize = layerSizes[layer];
-            weights[layer].resize(outputSize);
-            
-            for (int neuron = 0; neuron < outputSize; neuron++) {
-                weights[layer][neuron].resize(inputSize);
-                for (int input = 0; input < inputSize; input++) {
-                    float weight;
-                    file.read(reinterpret_cast<char*>(&weight), sizeof(float));
-                    weights[layer][neuron][input] = weight;
-                }
-            }
-        }
-
-        // Read biases
-        vector<vector<float>> biases(numLayers);
-        for (int layer = 0; layer < numLayers; layer++) {
-            int outputSize = layerSizes[layer + 1];
-            biases[layer].resize(outputSize);
-            for (int neuron = 0; neuron < outputSize; neuron++) {
-                float bias;
-                file.read(reinterpret_cast<char*>(&bias), sizeof(float));
-                biases[layer][neuron] = bias;
-            }
+        if (!file) {
+            cerr << "Error: Archivo de modelo incompleto: " << filename << endl;
+            file.close();
+            return false;
         }
 
         file.close();
 
-        // Set weights and biases in network
-        network.setWeights(weights);
-        network.setBiases(biases);
-
         cout << "Modelo cargado exitosamente desde: " << filename << endl;
         return true;
     }
@@ -195,29 +147,31 @@ public:
             return false;
         }
 
-        vector<vector<vector<float>>> weights = network.getWeights();
-        vector<vector<float>> biases = network.getBiases();
+        const vector<int>& layerSizes = network.getLayerSizes();
+        int numLayers = layerSizes.size() - 1;
+        const float* weights = network.weightData();
+        const float* biases = network.biasData();
 
-        file << weights.size() << endl;  // Number of layers
+        file << numLayers << endl;  // Number of layers
 
-        for (size_t layer = 0; layer < weights.size(); layer++) {
-            file << weights[layer].size() << " " << (layer == 0 ? weights[layer][0].size() : weights[layer - 1].size()) << endl;
+        for (int layer = 0; layer < numLayers; layer++) {
+            file << layerSizes[layer + 1] << " " << layerSizes[layer] << endl;
         }
 
         // Write weights
-        for (size_t layer = 0; layer < weights.size(); layer++) {
-            for (size_t neuron = 0; neuron < weights[layer].size(); neuron++) {
-                for (size_t input = 0; input < weights[layer][neuron].size(); input++) {
-                    file << weights[layer][neuron][input] << " ";
+        for (int layer = 0; layer < numLayers; layer++) {
+            for (int neuron = 0; neuron < layerSizes[layer + 1]; neuron++) {
+                for (int input = 0; input < layerSizes[layer]; input++) {
+                    file << *weights++ << " ";
                 }
                 file << endl;
             }
         }
 
         // Write biases
-        for (size_t layer = 0; layer < biases.size(); layer++) {
-            for (size_t neuron = 0; neuron < biases[layer].size(); neuron++) {
-                file << biases[layer][neuron] << " ";
+        for (int layer = 0; layer < numLayers; layer++) {
+            for (int neuron = 0; neuron < layerSizes[layer + 1]; neuron++) {
+                file << *biases++ << " ";
             }
             file << endl;
         }
@@ -2,89 +2,139 @@
 
 #include <vector>
 #include <cmath>
-#include <random>
 #include <algorithm>
+#include <cstring>
+#include "AlignedAllocator.h"
+#include "DenseKernels.h"
+#include "Random.h"
 
 using namespace std;
 
 class NeuralNetwork {
+public:
+    // Widest hidden layer predictQValuesInto evaluates without allocating
+    static const int STACK_LAYER_WIDTH = 64;
+    
 private:
     vector<int> layerSizes;
-    vector<vector<vector<float>>> weights;  // weights[layer][neuron][input]
-    vector<vector<float>> biases;           // biases[layer][neuron]
-    vector<vector<float>> activations;      // cache for forward pass
-    vector<vector<float>> zValues;          // cache for z (before activation)
     
-    random_device rd;
-    mt19937 gen;
-    uniform_real_distribution<float> dist;
+    // All layers live in one contiguous buffer each, row-major:
+    // weights[weightOffsets[layer] + neuron * layerSizes[layer] + input]
+    AlignedFloats weights;
+    AlignedFloats biases;       // biases[neuronOffsets[layer] + neuron]
+    AlignedFloats activations;  // cache for forward pass, activations[activationOffsets[layer] + i]
+    AlignedFloats zValues;      // cache for z (before activation), same layout as biases
+    AlignedFloats errors;       // backward scratch, same layout as biases
     
-    // Activation functions
-    float relu(float x) {
-        return max(0.0f, x);
-    }
+    // Mini-batch caches: each layer is a (layerSize x batch) matrix, one
+    // column per sample, stored at batchSize times the single-sample offset
+    int batchSize;
+    AlignedFloats batchActivations;
+    AlignedFloats batchZValues;
+    AlignedFloats batchErrors;
+    AlignedFloats weightGradients;
+    AlignedFloats biasGradients;
+    vector<int> weightOffsets;
+    vector<int> neuronOffsets;
+    vector<int> activationOffsets;
+    int widestHidden;
     
+    const DenseKernelSet* kernels;  // Dense/ReLU/softmax loops for this CPU
+    unsigned long version;          // Bumped whenever the parameters may change
+    
+    RandomStream rng;  // Weight initialization (child of RandomSeeds)
+    
+    // Activation functions
     float reluDerivative(float x) {
         return x > 0 ? 1.0f : 0.0f;
     }
     
-    vector<float> softmax(const vector<float>& x) {
-        vector<float> expX(x.size());
-        float maxVal = *max_element(x.begin(), x.end());
-        float sum = 0.0f;
+    // Xavier initialization
+    float xavierInit(int inputSize, int outputSize) {
+        float limit = sqrt(6.0f / (inputSize + outputSize));
+        return (rng.nextFloat() * 2.0f - 1.0f) * limit;
+    }
+    
+    // Size the buffers and offset tables for layerSizes (contents undefined)
+    void allocateStorage() {
+        int numLayers = layerSizes.size() - 1;
+        weightOffsets.resize(numLayers);
+        neuronOffsets.resize(numLayers);
+        activationOffsets.resize(layerSizes.size());
         
-        for (size_t i = 0; i < x.size(); i++) {
-            expX[i] = exp(x[i] - maxVal);  // Subtract max for numerical stability
-            sum += expX[i];
+        int weightCount = 0;
+        int neuronCount = 0;
+        int activationCount = 0;
+        for (int layer = 0; layer < numLayers; layer++) {
+            weightOffsets[layer] = weightCount;
+            neuronOffsets[layer] = neuronCount;
+            weightCount += layerSizes[layer] * layerSizes[layer + 1];
+            neuronCount += layerSizes[layer + 1];
         }
-        
-        for (size_t i = 0; i < expX.size(); i++) {
-            expX[i] /= sum;
+        widestHidden = 0;
+        for (size_t layer = 0; layer < layerSizes.size(); layer++) {
+            activationOffsets[layer] = activationCount;
+            activationCount += layerSizes[layer];
+            if (layer > 0 && layer + 1 < layerSizes.size()) {
+                widestHidden = max(widestHidden, layerSizes[layer]);
+            }
         }
         
-        return expX;
+        weights.assign(weightCount, 0.0f);
+        biases.assign(neuronCount, 0.0f);
+        zValues.assign(neuronCount, 0.0f);
+        errors.assign(neuronCount, 0.0f);
+        activations.assign(activationCount, 0.0f);
+        batchSize = 0;
+        version++;
     }
     
-    // Xavier initialization
-    float xavierInit(int inputSize, int outputSize) {
-        float limit = sqrt(6.0f / (inputSize + outputSize));
-        uniform_real_distribution<float> xavierDist(-limit, limit);
-        return xavierDist(gen);
+    // Grow the mini-batch caches to hold count samples
+    void reserveBatch(int count) {
+        batchSize = count;
+        if ((int)batchActivations.size() < count * (int)activations.size()) {
+            batchActivations.resize(count * activations.size());
+            batchZValues.resize(count * zValues.size());
+            batchErrors.resize(count * errors.size());
+        }
+        weightGradients.resize(weights.size());
+        biasGradients.resize(biases.size());
+    }
+    
+    // z = bias + W * input for one dense layer
+    void denseLayer(int layer, const float* input, float* z) const {
+        kernels->dense(&weights[weightOffsets[layer]], &biases[neuronOffsets[layer]], input,
+                       layerSizes[layer], layerSizes[layer + 1], z);
     }
     
 public:
-    NeuralNetwork(vector<int> sizes) : layerSizes(sizes), gen(rd()), dist(-1.0f, 1.0f) {
+    NeuralNetwork(vector<int> sizes)
+        : layerSizes(sizes), batchSize(0),
+          kernels(&DenseKernels::best()), version(0), rng(RandomSeeds::next()) {
         initializeNetwork();
     }
     
     // Constructor with custom hidden layer size
     NeuralNetwork(int inputSize, int hiddenSize, int outputSize) 
-        : layerSizes({inputSize, hiddenSize, outputSize}), gen(rd()), dist(-1.0f, 1.0f) {
+        : layerSizes({inputSize, hiddenSize, outputSize}), batchSize(0),
+          kernels(&DenseKernels::best()), version(0), rng(RandomSeeds::next()) {
         initializeNetwork();
     }
     
     // Initialize network layers
     void initializeNetwork() {
-        // Initialize weights and biases
-        weights.resize(layerSizes.size() - 1);
-        biases.resize(layerSizes.size() - 1);
-        activations.resize(layerSizes.size());
-        zValues.resize(layerSizes.size() - 1);
+        allocateStorage();
         
         for (size_t layer = 0; layer < layerSizes.size() - 1; layer++) {
             int inputSize = layerSizes[layer];
             int outputSize = layerSizes[layer + 1];
-            
-            weights[layer].resize(outputSize);
-            biases[layer].resize(outputSize);
-            zValues[layer].resize(outputSize);
+            float* w = &weights[weightOffsets[layer]];
             
             for (int neuron = 0; neuron < outputSize; neuron++) {
-                weights[layer][neuron].resize(inputSize);
                 for (int input = 0; input < inputSize; input++) {
-                    weights[layer][neuron][input] = xavierInit(inputSize, outputSize);
+                    w[neuron * inputSize + input] = xavierInit(inputSize, outputSize);
                 }
-                biases[layer][neuron] = 0.0f;
+                biases[neuronOffsets[layer] + neuron] = 0.0f;
             }
         }
     }
@@ -95,87 +145,79 @@ public:
             return vector<float>(layerSizes.back(), 0.0f);
         }
         
-        activations[0] = input;
+        copy(input.begin(), input.end(), activations.begin());
         
         // Forward through hidden layers
         for (size_t layer = 0; layer < layerSizes.size() - 2; layer++) {
             int layerSize = layerSizes[layer + 1];
-            activations[layer + 1].resize(layerSize);
-            zValues[layer].resize(layerSize);
+            float* z = &zValues[neuronOffsets[layer]];
+            float* a = &activations[activationOffsets[layer + 1]];
             
-            for (int neuron = 0; neuron < layerSize; neuron++) {
-                float z = biases[layer][neuron];
-                for (int input = 0; input < layerSizes[layer]; input++) {
-                    z += activations[layer][input] * weights[layer][neuron][input];
-                }
-                zValues[layer][neuron] = z;
-                activations[layer + 1][neuron] = relu(z);
-            }
+            denseLayer(layer, &activations[activationOffsets[layer]], z);
+            kernels->relu(z, a, layerSize);
         }
         
         // Output layer with softmax
         int outputLayer = layerSizes.size() - 2;
-        int outputSize = layerSizes.back();
-        activations.back().resize(outputSize);
-        zValues[outputLayer].resize(outputSize);
-        
-        for (int neuron = 0; neuron < outputSize; neuron++) {
-            float z = biases[outputLayer][neuron];
-            for (int input = 0; input < layerSizes[outputLayer]; input++) {
-                z += activations[outputLayer][input] * weights[outputLayer][neuron][input];
-            }
-            zValues[outputLayer][neuron] = z;
-        }
+        float* z = &zValues[neuronOffsets[outputLayer]];
+        denseLayer(outputLayer, &activations[activationOffsets[outputLayer]], z);
         
-        return softmax(zValues[outputLayer]);
+        vector<float> probabilities(layerSizes.back());
+        kernels->softmax(z, probabilities.data(), layerSizes.back());
+        return probabilities;
     }
     
     // Backward propagation (for Q-Learning, we'll use a simplified version)
     void backward(const vector<float>& target, float learningRate) {
         if (target.size() != layerSizes.back()) return;
+        version++;
         
         int numLayers = layerSizes.size() - 1;
         
         // Calculate output error (for Q-Learning, target is the Q-value)
-        vector<float> outputError(layerSizes.back());
-        for (size_t i = 0; i < outputError.size(); i++) {
-            outputError[i] = target[i] - zValues[numLayers - 1][i];
+        float* outputError = &errors[neuronOffsets[numLayers - 1]];
+        const float* outputZ = &zValues[neuronOffsets[numLayers - 1]];
+        for (int i = 0; i < layerSizes.back(); i++) {
+            outputError[i] = target[i] - outputZ[i];
         }
         
-        // Backpropagate through layers
-        vector<vector<float>> errors(numLayers);
-        errors[numLayers - 1] = outputError;
-        
         // Backpropagate from output to input
         for (int layer = numLayers - 1; layer >= 0; layer--) {
             int currentLayerSize = layerSizes[layer + 1];
             int prevLayerSize = layerSizes[layer];
+            float* w = &weights[weightOffsets[layer]];
+            float* b = &biases[neuronOffsets[layer]];
+            const float* z = &zValues[neuronOffsets[layer]];
+            const float* error = &errors[neuronOffsets[layer]];
+            const float* input = &activations[activationOffsets[layer]];
             
             // Calculate errors for previous layer
             if (layer > 0) {
-                errors[layer - 1].resize(prevLayerSize, 0.0f);
+                float* prevError = &errors[neuronOffsets[layer - 1]];
                 for (int prevNeuron = 0; prevNeuron < prevLayerSize; prevNeuron++) {
+                    prevError[prevNeuron] = 0.0f;
                     for (int currNeuron = 0; currNeuron < currentLayerSize; currNeuron++) {
-                        errors[layer - 1][prevNeuron] += 
-                            errors[layer][currNeuron] * weights[layer][currNeuron][prevNeuron] *
-                            reluDerivative(zValues[layer][currNeuron]);
+                        prevError[prevNeuron] += 
+                            error[currNeuron] * w[currNeuron * prevLayerSize + prevNeuron] *
+                            reluDerivative(z[currNeuron]);
                     }
                 }
             }
             
             // Update weights and biases
             for (int neuron = 0; neuron < currentLayerSize; neuron++) {
-                float error = errors[layer][neuron];
+                float neuronError = error[neuron];
                 if (layer < numLayers - 1) {
-                    error *= reluDerivative(zValues[layer][neuron]);
+                    neuronError *= reluDerivative(z[neuron]);
                 }
                 
                 // Update bias
-                biases[layer][neuron] += learningRate * error;
+                b[neuron] += learningRate * neuronError;
                 
                 // Update weights
-                for (int input = 0; input < prevLayerSize; input++) {
-                    weights[layer][neuron][input] += learningRate * error * activations[layer][input];
+                float* row = w + neuron * prevLayerSize;
+                for (int i = 0; i < prevLayerSize; i++) {
+                    row[i] += learningRate * neuronError * input[i];
                 }
             }
         }
@@ -187,57 +229,335 @@ public:
             return vector<float>(layerSizes.back(), 0.0f);
         }
         
-        activations[0] = input;
+        vector<float> qValues(layerSizes.back());
+        getQValuesInto(input.data(), qValues.data());
+        return qValues;
+    }
+    
+    // Allocation-free getQValues: input holds layerSizes[0] values, out
+    // receives layerSizes.back() Q-values. Hidden activations go to the
+    // network's own cache.
+    void getQValuesInto(const float* input, float* out) {
+        copy(input, input + layerSizes[0], activations.begin());
         
         // Forward through hidden layers
         for (size_t layer = 0; layer < layerSizes.size() - 2; layer++) {
             int layerSize = layerSizes[layer + 1];
-            activations[layer + 1].resize(layerSize);
+            float* a = &activations[activationOffsets[layer + 1]];
             
-            for (int neuron = 0; neuron < layerSize; neuron++) {
-                float z = biases[layer][neuron];
-                for (int inputIdx = 0; inputIdx < layerSizes[layer]; inputIdx++) {
-                    z += activations[layer][inputIdx] * weights[layer][neuron][inputIdx];
-                }
-                activations[layer + 1][neuron] = relu(z);
-            }
+            denseLayer(layer, &activations[activationOffsets[layer]], a);
+            kernels->relu(a, a, layerSize);
+        }
+        
+        // Output layer (raw Q-values, no softmax)
+        int outputLayer = layerSizes.size() - 2;
+        denseLayer(outputLayer, &activations[activationOffsets[outputLayer]], out);
+    }
+    
+    // Read-only Q-value evaluation: same math as getQValuesInto, but keeps
+    // its intermediate activations local so several threads can share the
+    // network. Hidden layers up to STACK_LAYER_WIDTH units are evaluated in
+    // stack buffers; wider ones fall back to the heap.
+    void predictQValuesInto(const float* input, float* out) const {
+        float stackBuffers[2][STACK_LAYER_WIDTH];
+        vector<float> heapBuffers;
+        float* current = stackBuffers[0];
+        float* next = stackBuffers[1];
+        if (widestHidden > STACK_LAYER_WIDTH) {
+            heapBuffers.resize(2 * widestHidden);
+            current = &heapBuffers[0];
+            next = &heapBuffers[widestHidden];
+        }
+        
+        // Forward through hidden layers
+        const float* layerInput = input;
+        for (size_t layer = 0; layer < layerSizes.size() - 2; layer++) {
+            int layerSize = layerSizes[layer + 1];
+            denseLayer(layer, layerInput, next);
+            kernels->relu(next, next, layerSize);
+            swap(current, next);
+            layerInput = current;
         }
         
         // Output layer (raw Q-values, no softmax)
         int outputLayer = layerSizes.size() - 2;
+        denseLayer(outputLayer, layerInput, out);
+    }
+    
+    // Mini-batch forward pass: inputs is a (count x inputSize) row-major
+    // matrix, one sample per row. Internally every layer is kept
+    // feature-major (layerSize x count), so each weight multiplies a
+    // contiguous run of samples and the inner loops vectorize like a GEMM.
+    // Returns the (outputSize x count) matrix of raw Q-values, valid until
+    // the next batch call; pre-activations are kept for backwardBatch.
+    const float* forwardBatch(const float* inputs, int count) {
+        reserveBatch(count);
+        
+        float* in0 = &batchActivations[0];
+        for (int sample = 0; sample < count; sample++) {
+            for (int i = 0; i < layerSizes[0]; i++) {
+                in0[i * count + sample] = inputs[sample * layerSizes[0] + i];
+            }
+        }
+        
+        int numLayers = layerSizes.size() - 1;
+        for (int layer = 0; layer < numLayers; layer++) {
+            int inputSize = layerSizes[layer];
+            int outputSize = layerSizes[layer + 1];
+            const float* w = &weights[weightOffsets[layer]];
+            const float* b = &biases[neuronOffsets[layer]];
+            const float* in = &batchActivations[activationOffsets[layer] * count];
+            float* z = &batchZValues[neuronOffsets[layer] * count];
+            float* out = &batchActivations[activationOffsets[layer + 1] * count];
+            
+            for (int neuron = 0; neuron < outputSize; neuron++) {
+                const float* row = w + neuron * inputSize;
+                float* zRow = z + neuron * count;
+                for (int sample = 0; sample < count; sample++) {
+                    zRow[sample] = b[neuron];
+                }
+                for (int i = 0; i < inputSize; i++) {
+                    float weight = row[i];
+                    const float* x = in + i * count;
+                    for (int sample = 0; sample < count; sample++) {
+                        zRow[sample] += weight * x[sample];
+                    }
+                }
+                
+                float* outRow = out + neuron * count;
+                if (layer < numLayers - 1) {
+                    for (int sample = 0; sample < count; sample++) {
+                        outRow[sample] = max(0.0f, zRow[sample]);
+                    }
+                } else {
+                    copy(zRow, zRow + count, outRow);
+                }
+            }
+        }
+        
+        return &batchActivations[activationOffsets.back() * count];
+    }
+    
+    // Mini-batch Q-learning update after forwardBatch: for each sample only
+    // the Q-value of actions[s] is pulled towards targets[s]. Gradients of
+    // the whole batch are accumulated and applied once, summed rather than
+    // averaged so the step size matches per-sample fitQValue calls.
+    // Optional: sampleWeights scale each sample's error (importance
+    // sampling), tdErrors receives each sample's unweighted error.
+    void backwardBatch(const int* actions, const float* targets, float learningRate,
+                       const float* sampleWeights = nullptr, float* tdErrors = nullptr) {
+        int count = batchSize;
+        int numLayers = layerSizes.size() - 1;
         int outputSize = layerSizes.back();
-        vector<float> qValues(outputSize);
+        version++;
         
-        for (int neuron = 0; neuron < outputSize; neuron++) {
-            float z = biases[outputLayer][neuron];
-            for (int inputIdx = 0; inputIdx < layerSizes[outputLayer]; inputIdx++) {
-                z += activations[outputLayer][inputIdx] * weights[outputLayer][neuron][inputIdx];
+        // Output error: TD error on the taken action, zero elsewhere
+        float* outputError = &batchErrors[neuronOffsets[numLayers - 1] * count];
+        const float* outputZ = &batchZValues[neuronOffsets[numLayers - 1] * count];
+        fill(outputError, outputError + outputSize * count, 0.0f);
+        for (int sample = 0; sample < count; sample++) {
+            int a = actions[sample] * count + sample;
+            float tdError = targets[sample] - outputZ[a];
+            if (tdErrors) {
+                tdErrors[sample] = tdError;
             }
-            qValues[neuron] = z;
+            outputError[a] = sampleWeights ? tdError * sampleWeights[sample] : tdError;
         }
         
-        return qValues;
+        for (int layer = numLayers - 1; layer >= 0; layer--) {
+            int currentLayerSize = layerSizes[layer + 1];
+            int prevLayerSize = layerSizes[layer];
+            const float* w = &weights[weightOffsets[layer]];
+            const float* error = &batchErrors[neuronOffsets[layer] * count];
+            const float* input = &batchActivations[activationOffsets[layer] * count];
+            float* wGrad = &weightGradients[weightOffsets[layer]];
+            float* bGrad = &biasGradients[neuronOffsets[layer]];
+            
+            // Gradients summed over the batch: dW = error * input^T
+            for (int neuron = 0; neuron < currentLayerSize; neuron++) {
+                const float* e = error + neuron * count;
+                float biasSum = 0.0f;
+                for (int sample = 0; sample < count; sample++) {
+                    biasSum += e[sample];
+                }
+                bGrad[neuron] = biasSum;
+                
+                for (int i = 0; i < prevLayerSize; i++) {
+                    const float* x = input + i * count;
+                    float sum = 0.0f;
+                    for (int sample = 0; sample < count; sample++) {
+                        sum += e[sample] * x[sample];
+                    }
+                    wGrad[neuron * prevLayerSize + i] = sum;
+                }
+            }
+            
+            // Errors for the previous (ReLU) layer, with the weights used in
+            // the forward pass: W^T * error, masked by the ReLU derivative
+            if (layer > 0) {
+                float* prevError = &batchErrors[neuronOffsets[layer - 1] * count];
+                const float* prevZ = &batchZValues[neuronOffsets[layer - 1] * count];
+                fill(prevError, prevError + prevLayerSize * count, 0.0f);
+                for (int neuron = 0; neuron < currentLayerSize; neuron++) {
+                    const float* e = error + neuron * count;
+                    for (int i = 0; i < prevLayerSize; i++) {
+                        float weight = w[neuron * prevLayerSize + i];
+                        float* pe = prevError + i * count;
+                        for (int sample = 0; sample < count; sample++) {
+                            pe[sample] += weight * e[sample];
+                        }
+                    }
+                }
+                for (int i = 0; i < prevLayerSize * count; i++) {
+                    prevError[i] = prevZ[i] > 0 ? prevError[i] : 0.0f;
+                }
+            }
+        }
+        
+        // One update for the whole batch
+        for (size_t i = 0; i < weights.size(); i++) {
+            weights[i] += learningRate * weightGradients[i];
+        }
+        for (size_t i = 0; i < biases.size(); i++) {
+            biases[i] += learningRate * biasGradients[i];
+        }
     }
     
     // Update Q-value for a specific action (simplified Q-Learning update)
     void updateQValue(const vector<float>& state, int action, float targetQ, float learningRate) {
-        vector<float> qValues = getQValues(state);
-        vector<float> target = qValues;
-        target[action] = targetQ;
-        backward(target, learningRate);
+        if ((int)state.size() != layerSizes[0]) return;
+        fitQValue(state.data(), action, targetQ, learningRate);
     }
     
-    // Get weights and biases for saving/loading
-    vector<vector<vector<float>>> getWeights() const { return weights; }
-    vector<vector<float>> getBiases() const { return biases; }
-    vector<int> getLayerSizes() const { return layerSizes; }
+    // Pull Q(state, action) towards targetQ with one forward pass (caching
+    // pre-activations and activations for this very sample) followed by
+    // in-place backpropagation of the error of that action only.
+    // Returns the error before the update.
+    float fitQValue(const float* state, int action, float targetQ, float learningRate) {
+        int numLayers = layerSizes.size() - 1;
+        int outputLayer = numLayers - 1;
+        version++;
+        
+        // Forward, keeping z and activations of every layer
+        copy(state, state + layerSizes[0], activations.begin());
+        for (int layer = 0; layer < outputLayer; layer++) {
+            float* z = &zValues[neuronOffsets[layer]];
+            denseLayer(layer, &activations[activationOffsets[layer]], z);
+            kernels->relu(z, &activations[activationOffsets[layer + 1]], layerSizes[layer + 1]);
+        }
+        float* outputZ = &zValues[neuronOffsets[outputLayer]];
+        denseLayer(outputLayer, &activations[activationOffsets[outputLayer]], outputZ);
+        
+        // Output error: only the action taken has a target
+        float* outputError = &errors[neuronOffsets[outputLayer]];
+        fill(outputError, outputError + layerSizes.back(), 0.0f);
+        float tdError = targetQ - outputZ[action];
+        outputError[action] = tdError;
+        
+        for (int layer = outputLayer; layer >= 0; layer--) {
+            int currentLayerSize = layerSizes[layer + 1];
+            int prevLayerSize = layerSizes[layer];
+            float* w = &weights[weightOffsets[layer]];
+            float* b = &biases[neuronOffsets[layer]];
+            const float* error = &errors[neuronOffsets[layer]];
+            const float* input = &activations[activationOffsets[layer]];
+            
+            // Previous layer's error (through the ReLU) before W changes
+            if (layer > 0) {
+                float* prevError = &errors[neuronOffsets[layer - 1]];
+                const float* prevZ = &zValues[neuronOffsets[layer - 1]];
+                fill(prevError, prevError + prevLayerSize, 0.0f);
+                for (int neuron = 0; neuron < currentLayerSize; neuron++) {
+                    float e = error[neuron];
+                    if (e == 0.0f) continue;
+                    const float* row = w + neuron * prevLayerSize;
+                    for (int i = 0; i < prevLayerSize; i++) {
+                        prevError[i] += e * row[i];
+                    }
+                }
+                for (int i = 0; i < prevLayerSize; i++) {
+                    prevError[i] *= reluDerivative(prevZ[i]);
+                }
+            }
+            
+            // Update weights and biases
+            for (int neuron = 0; neuron < currentLayerSize; neuron++) {
+                float step = learningRate * error[neuron];
+                if (step == 0.0f) continue;
+                b[neuron] += step;
+                float* row = w + neuron * prevLayerSize;
+                for (int i = 0; i < prevLayerSize; i++) {
+                    row[i] += step * input[i];
+                }
+            }
+        }
+        
+        return tdError;
+    }
+    
+    // Fused Q-learning step for one transition: the TD target
+    // reward + discount * max Q(nextState) is evaluated first (read-only),
+    // then fitQValue trains state towards it. Returns the TD error.
+    float trainStep(const float* state, int action, float reward, const float* nextState,
+                    bool done, float discountFactor, float learningRate) {
+        float targetQ = reward;
+        if (!done) {
+            int outputSize = layerSizes.back();
+            float stackQ[STACK_LAYER_WIDTH];
+            vector<float> heapQ;
+            float* nextQ = stackQ;
+            if (outputSize > STACK_LAYER_WIDTH) {
+                heapQ.resize(outputSize);
+                nextQ = heapQ.data();
+            }
+            predictQValuesInto(nextState, nextQ);
+            targetQ += discountFactor * *max_element(nextQ, nextQ + outputSize);
+        }
+        return fitQValue(state, action, targetQ, learningRate);
+    }
+    
+    // Flat parameter access for saving/loading: weights of every layer
+    // row-major (layer, neuron, input), then biases (layer, neuron)
+    const vector<int>& getLayerSizes() const { return layerSizes; }
+    float* weightData() { version++; return weights.data(); }
+    const float* weightData() const { return weights.data(); }
+    int weightCount() const { return weights.size(); }
+    float* biasData() { version++; return biases.data(); }
+    const float* biasData() const { return biases.data(); }
+    int biasCount() const { return biases.size(); }
     
-    void setWeights(const vector<vector<vector<float>>>& w) { weights = w; }
-    void setBiases(const vector<vector<float>>& b) { biases = b; }
+    // Changes on every parameter update, so copies of the weights (see
+    // FixedPolicy) can tell whether they are stale. Mutable data access counts.
+    unsigned long getVersion() const { return version; }
+    
+    // Force a narrower inference kernel set (e.g. Scalar to compare results)
+    SimdLevel getSimdLevel() const { return kernels->level; }
+    void setSimdLevel(SimdLevel level) {
+        if (level > CpuFeatures::detect()) {
+            level = CpuFeatures::detect();
+        }
+        kernels = &DenseKernels::get(level);
+    }
+    
+    // Take a new weight-initialization stream from RandomSeeds, as a newly
+    // constructed network would
+    void reseed() {
+        rng = RandomSeeds::next();
+    }
+    
+    // Change the topology (e.g. to match a loaded file). If it changes, the
+    // parameters are reallocated and zeroed; the same sizes keep them intact.
+    void setLayerSizes(const vector<int>& sizes) {
+        if (sizes == layerSizes) return;
+        layerSizes = sizes;
+        allocateStorage();
+    }
     
     // Copy weights and biases to another network
     void copyTo(NeuralNetwork& target) const {
-        target.weights = this->weights;
-        target.biases = this->biases;
+        target.setLayerSizes(layerSizes);
+        memcpy(target.weights.data(), weights.data(), weights.size() * sizeof(float));
+        memcpy(target.biases.data(), biases.data(), biases.size() * sizeof(float));
+        target.version++;
     }
 };
@@ -0,0 +1,326 @@
+#pragma once
+
+#include "CpuFeatures.h"
+#include "MatchPhysics.h"
+
+// Per-frame physics of BatchSimulator lanes: paddle movement, ball
+// integration, wall reflection, swept paddle collision and goal detection.
+// There is one kernel per instruction set; all of them produce bit-identical
+// results (same operation order, selects instead of arithmetic on masks,
+// max/min operands ordered like std::max/std::min). The build passes
+// -ffp-contract=off so no multiply-add gets fused into an FMA on one path only.
+
+// Structure-of-arrays view over the active lanes
+struct PhysicsLanes {
+    int count;
+
+    float* ballX;
+    float* ballY;
+    float* dirX;
+    float* dirY;
+
+    const float* paddleX[2];
+    float* paddleY[2];
+    const float* paddleW[2];
+    const float* paddleH[2];
+    const float* paddleSpeed[2];
+    const int* action[2];  // 0 = up, 1 = stay, 2 = down
+    int* lastHit[2];       // 1 while the ball overlaps the paddle
+
+    int* scorer;  // Output: 0 in play, 1 left scored, 2 right scored
+};
+
+struct PhysicsParams {
+    float fieldWidth;
+    float fieldHeight;
+    float ballSpeed;
+    float ballSize;
+    float dt;
+};
+
+typedef void (*PhysicsKernel)(const PhysicsLanes& lanes, const PhysicsParams& params);
+
+namespace PhysicsKernels {
+    // One lane, same math as MatchPhysics::movePaddleY / stepBall (without
+    // the serve). Used by the scalar kernel and for the SIMD kernels' tails.
+    inline void stepLane(const PhysicsLanes& l, const PhysicsParams& p, int i) {
+        for (int s = 0; s < 2; s++) {
+            float current = l.paddleY[s][i];
+            float up = current - l.paddleSpeed[s][i] * p.dt;
+            up = (up < 0) ? 0.0f : up;
+            float down = current + l.paddleSpeed[s][i] * p.dt;
+            down = (down + l.paddleH[s][i] > p.fieldHeight) ? p.fieldHeight - l.paddleH[s][i] : down;
+            int a = l.action[s][i];
+            float moved = (a == 2) ? down : current;
+            l.paddleY[s][i] = (a == 0) ? up : moved;
+        }
+
+        float startX = l.ballX[i];
+        float startY = l.ballY[i];
+        float vx = l.dirX[i] * p.ballSpeed;
+        float vy = l.dirY[i] * p.ballSpeed;
+
+        l.ballX[i] = startX + vx * p.dt;
+        float y = startY + vy * p.dt;
+        int top = y < 0;
+        int bottom = (y + p.ballSize > p.fieldHeight) & !top;
+        float clamped = bottom ? p.fieldHeight - p.ballSize : y;
+        l.ballY[i] = top ? 0.0f : clamped;
+        l.dirY[i] = (top | bottom) ? -l.dirY[i] : l.dirY[i];
+
+        for (int s = 0; s < 2; s++) {
+            float enter, exit;
+            bool touches = MatchPhysics::sweptOverlap(
+                startX, startY, p.ballSize, p.ballSize, vx, vy,
+                l.paddleX[s][i], l.paddleY[s][i], l.paddleW[s][i], l.paddleH[s][i], 0.0f, 0.0f,
+                enter, exit
+            );
+            int hit = touches & (enter < p.dt) & (exit > 0);
+            if (hit & (l.lastHit[s][i] == 0)) {
+                float impact = max(enter, 0.0f);
+                l.dirX[i] = -l.dirX[i];
+                l.ballX[i] = (startX + vx * impact) - vx * (p.dt - impact);
+            }
+            l.lastHit[s][i] = hit;
+        }
+
+        float bx = l.ballX[i];
+        l.scorer[i] = (bx < -p.ballSize) ? 2 : ((bx > p.fieldWidth) ? 1 : 0);
+    }
+
+    inline void stepScalar(const PhysicsLanes& lanes, const PhysicsParams& params) {
+        for (int i = 0; i < lanes.count; i++) {
+            stepLane(lanes, params, i);
+        }
+    }
+
+#if PONG_SIMD_X86
+    // Lane-wise select: mask ? a : b
+    __attribute__((target("sse2")))
+    inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // MatchPhysics::sweptAxis for 4 lanes; returns the lanes that may overlap
+    __attribute__((target("sse2")))
+    inline __m128 sweptAxis4(__m128 a, __m128 aSize, __m128 b, __m128 bSize, __m128 v,
+                             __m128& tEnter, __m128& tExit) {
+        __m128 still = _mm_cmpeq_ps(v, _mm_setzero_ps());
+        __m128 t0 = _mm_div_ps(_mm_sub_ps(_mm_sub_ps(b, aSize), a), v);
+        __m128 t1 = _mm_div_ps(_mm_sub_ps(_mm_add_ps(b, bSize), a), v);
+        __m128 swapped = _mm_cmpgt_ps(t0, t1);
+        __m128 lo = select4(swapped, t1, t0);
+        __m128 hi = select4(swapped, t0, t1);
+        tEnter = select4(still, tEnter, _mm_max_ps(lo, tEnter));
+        tExit = select4(still, tExit, _mm_min_ps(hi, tExit));
+        __m128 staticOverlap = _mm_and_ps(_mm_cmplt_ps(a, _mm_add_ps(b, bSize)),
+                                          _mm_cmplt_ps(b, _mm_add_ps(a, aSize)));
+        __m128 allLanes = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        return select4(still, staticOverlap, allLanes);
+    }
+
+    __attribute__((target("sse2")))
+    inline void stepSSE2(const PhysicsLanes& l, const PhysicsParams& p) {
+        const int vecEnd = l.count & ~3;
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+        const __m128 dt = _mm_set1_ps(p.dt);
+        const __m128 height = _mm_set1_ps(p.fieldHeight);
+        const __m128 width = _mm_set1_ps(p.fieldWidth);
+        const __m128 speed = _mm_set1_ps(p.ballSpeed);
+        const __m128 size = _mm_set1_ps(p.ballSize);
+        const __m128 negSize = _mm_set1_ps(-p.ballSize);
+        const __m128 maxBallY = _mm_set1_ps(p.fieldHeight - p.ballSize);
+        const __m128i zeroI = _mm_setzero_si128();
+        const __m128i oneI = _mm_set1_epi32(1);
+        const __m128i twoI = _mm_set1_epi32(2);
+
+        for (int i = 0; i < vecEnd; i += 4) {
+            for (int s = 0; s < 2; s++) {
+                __m128 current = _mm_loadu_ps(l.paddleY[s] + i);
+                __m128 h = _mm_loadu_ps(l.paddleH[s] + i);
+                __m128 step = _mm_mul_ps(_mm_loadu_ps(l.paddleSpeed[s] + i), dt);
+                __m128 up = _mm_sub_ps(current, step);
+                up = _mm_andnot_ps(_mm_cmplt_ps(up, zero), up);
+                __m128 down = _mm_add_ps(current, step);
+                down = select4(_mm_cmpgt_ps(_mm_add_ps(down, h), height), _mm_sub_ps(height, h), down);
+                __m128i a = _mm_loadu_si128((const __m128i*)(l.action[s] + i));
+                __m128 moved = select4(_mm_castsi128_ps(_mm_cmpeq_epi32(a, twoI)), down, current);
+                _mm_storeu_ps(l.paddleY[s] + i, select4(_mm_castsi128_ps(_mm_cmpeq_epi32(a, zeroI)), up, moved));
+            }
+
+            __m128 startX = _mm_loadu_ps(l.ballX + i);
+            __m128 startY = _mm_loadu_ps(l.ballY + i);
+            __m128 dx = _mm_loadu_ps(l.dirX + i);
+            __m128 dy = _mm_loadu_ps(l.dirY + i);
+            __m128 vx = _mm_mul_ps(dx, speed);
+            __m128 vy = _mm_mul_ps(dy, speed);
+
+            __m128 bx = _mm_add_ps(startX, _mm_mul_ps(vx, dt));
+            __m128 y = _mm_add_ps(startY, _mm_mul_ps(vy, dt));
+            __m128 top = _mm_cmplt_ps(y, zero);
+            __m128 bottom = _mm_andnot_ps(top, _mm_cmpgt_ps(_mm_add_ps(y, size), height));
+            __m128 by = _mm_andnot_ps(top, select4(bottom, maxBallY, y));
+            dy = _mm_xor_ps(dy, _mm_and_ps(_mm_or_ps(top, bottom), signBit));
+
+            for (int s = 0; s < 2; s++) {
+                __m128 enter = _mm_set1_ps(-numeric_limits<float>::infinity());
+                __m128 exit = _mm_set1_ps(numeric_limits<float>::infinity());
+                __m128 touches = _mm_and_ps(
+                    sweptAxis4(startX, size, _mm_loadu_ps(l.paddleX[s] + i), _mm_loadu_ps(l.paddleW[s] + i),
+                               vx, enter, exit),
+                    sweptAxis4(startY, size, _mm_loadu_ps(l.paddleY[s] + i), _mm_loadu_ps(l.paddleH[s] + i),
+                               vy, enter, exit));
+                touches = _mm_and_ps(touches, _mm_cmplt_ps(enter, exit));
+                __m128 hit = _mm_and_ps(touches, _mm_and_ps(_mm_cmplt_ps(enter, dt), _mm_cmpgt_ps(exit, zero)));
+                __m128i before = _mm_loadu_si128((const __m128i*)(l.lastHit[s] + i));
+                __m128 flip = _mm_and_ps(hit, _mm_castsi128_ps(_mm_cmpeq_epi32(before, zeroI)));
+                __m128 impact = _mm_max_ps(zero, enter);
+                __m128 reflectedX = _mm_sub_ps(_mm_add_ps(startX, _mm_mul_ps(vx, impact)),
+                                               _mm_mul_ps(vx, _mm_sub_ps(dt, impact)));
+                bx = select4(flip, reflectedX, bx);
+                dx = _mm_xor_ps(dx, _mm_and_ps(flip, signBit));
+                _mm_storeu_si128((__m128i*)(l.lastHit[s] + i), _mm_and_si128(_mm_castps_si128(hit), oneI));
+            }
+
+            __m128i leftGoal = _mm_castps_si128(_mm_cmplt_ps(bx, negSize));
+            __m128i rightGoal = _mm_castps_si128(_mm_cmpgt_ps(bx, width));
+            __m128i goal = _mm_or_si128(_mm_and_si128(leftGoal, twoI),
+                                        _mm_andnot_si128(leftGoal, _mm_and_si128(rightGoal, oneI)));
+
+            _mm_storeu_ps(l.ballX + i, bx);
+            _mm_storeu_ps(l.ballY + i, by);
+            _mm_storeu_ps(l.dirX + i, dx);
+            _mm_storeu_ps(l.dirY + i, dy);
+            _mm_storeu_si128((__m128i*)(l.scorer + i), goal);
+        }
+
+        for (int i = vecEnd; i < l.count; i++) {
+            stepLane(l, p, i);
+        }
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256 select8(__m256 mask, __m256 a, __m256 b) {
+        return _mm256_blendv_ps(b, a, mask);
+    }
+
+    // MatchPhysics::sweptAxis for 8 lanes; returns the lanes that may overlap
+    __attribute__((target("avx2")))
+    inline __m256 sweptAxis8(__m256 a, __m256 aSize, __m256 b, __m256 bSize, __m256 v,
+                             __m256& tEnter, __m256& tExit) {
+        __m256 still = _mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_EQ_OQ);
+        __m256 t0 = _mm256_div_ps(_mm256_sub_ps(_mm256_sub_ps(b, aSize), a), v);
+        __m256 t1 = _mm256_div_ps(_mm256_sub_ps(_mm256_add_ps(b, bSize), a), v);
+        __m256 swapped = _mm256_cmp_ps(t0, t1, _CMP_GT_OQ);
+        __m256 lo = select8(swapped, t1, t0);
+        __m256 hi = select8(swapped, t0, t1);
+        tEnter = select8(still, tEnter, _mm256_max_ps(lo, tEnter));
+        tExit = select8(still, tExit, _mm256_min_ps(hi, tExit));
+        __m256 staticOverlap = _mm256_and_ps(_mm256_cmp_ps(a, _mm256_add_ps(b, bSize), _CMP_LT_OQ),
+                                             _mm256_cmp_ps(b, _mm256_add_ps(a, aSize), _CMP_LT_OQ));
+        __m256 allLanes = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        return select8(still, staticOverlap, allLanes);
+    }
+
+    __attribute__((target("avx2")))
+    inline void stepAVX2(const PhysicsLanes& l, const PhysicsParams& p) {
+        const int vecEnd = l.count & ~7;
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 signBit = _mm256_set1_ps(-0.0f);
+        const __m256 dt = _mm256_set1_ps(p.dt);
+        const __m256 height = _mm256_set1_ps(p.fieldHeight);
+        const __m256 width = _mm256_set1_ps(p.fieldWidth);
+        const __m256 speed = _mm256_set1_ps(p.ballSpeed);
+        const __m256 size = _mm256_set1_ps(p.ballSize);
+        const __m256 negSize = _mm256_set1_ps(-p.ballSize);
+        const __m256 maxBallY = _mm256_set1_ps(p.fieldHeight - p.ballSize);
+        const __m256i zeroI = _mm256_setzero_si256();
+        const __m256i oneI = _mm256_set1_epi32(1);
+        const __m256i twoI = _mm256_set1_epi32(2);
+
+        for (int i = 0; i < vecEnd; i += 8) {
+            for (int s = 0; s < 2; s++) {
+                __m256 current = _mm256_loadu_ps(l.paddleY[s] + i);
+                __m256 h = _mm256_loadu_ps(l.paddleH[s] + i);
+                __m256 step = _mm256_mul_ps(_mm256_loadu_ps(l.paddleSpeed[s] + i), dt);
+                __m256 up = _mm256_sub_ps(current, step);
+                up = _mm256_andnot_ps(_mm256_cmp_ps(up, zero, _CMP_LT_OQ), up);
+                __m256 down = _mm256_add_ps(current, step);
+                down = select8(_mm256_cmp_ps(_mm256_add_ps(down, h), height, _CMP_GT_OQ),
+                               _mm256_sub_ps(height, h), down);
+                __m256i a = _mm256_loadu_si256((const __m256i*)(l.action[s] + i));
+                __m256 moved = select8(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, twoI)), down, current);
+                _mm256_storeu_ps(l.paddleY[s] + i,
+                                 select8(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, zeroI)), up, moved));
+            }
+
+            __m256 startX = _mm256_loadu_ps(l.ballX + i);
+            __m256 startY = _mm256_loadu_ps(l.ballY + i);
+            __m256 dx = _mm256_loadu_ps(l.dirX + i);
+            __m256 dy = _mm256_loadu_ps(l.dirY + i);
+            __m256 vx = _mm256_mul_ps(dx, speed);
+            __m256 vy = _mm256_mul_ps(dy, speed);
+
+            __m256 bx = _mm256_add_ps(startX, _mm256_mul_ps(vx, dt));
+            __m256 y = _mm256_add_ps(startY, _mm256_mul_ps(vy, dt));
+            __m256 top = _mm256_cmp_ps(y, zero, _CMP_LT_OQ);
+            __m256 bottom = _mm256_andnot_ps(top, _mm256_cmp_ps(_mm256_add_ps(y, size), height, _CMP_GT_OQ));
+            __m256 by = _mm256_andnot_ps(top, select8(bottom, maxBallY, y));
+            dy = _mm256_xor_ps(dy, _mm256_and_ps(_mm256_or_ps(top, bottom), signBit));
+
+            for (int s = 0; s < 2; s++) {
+                __m256 enter = _mm256_set1_ps(-numeric_limits<float>::infinity());
+                __m256 exit = _mm256_set1_ps(numeric_limits<float>::infinity());
+                __m256 touches = _mm256_and_ps(
+                    sweptAxis8(startX, size, _mm256_loadu_ps(l.paddleX[s] + i), _mm256_loadu_ps(l.paddleW[s] + i),
+                               vx, enter, exit),
+                    sweptAxis8(startY, size, _mm256_loadu_ps(l.paddleY[s] + i), _mm256_loadu_ps(l.paddleH[s] + i),
+                               vy, enter, exit));
+                touches = _mm256_and_ps(touches, _mm256_cmp_ps(enter, exit, _CMP_LT_OQ));
+                __m256 hit = _mm256_and_ps(touches, _mm256_and_ps(_mm256_cmp_ps(enter, dt, _CMP_LT_OQ),
+                                                                  _mm256_cmp_ps(exit, zero, _CMP_GT_OQ)));
+                __m256i before = _mm256_loadu_si256((const __m256i*)(l.lastHit[s] + i));
+                __m256 flip = _mm256_and_ps(hit, _mm256_castsi256_ps(_mm256_cmpeq_epi32(before, zeroI)));
+                __m256 impact = _mm256_max_ps(zero, enter);
+                __m256 reflectedX = _mm256_sub_ps(_mm256_add_ps(startX, _mm256_mul_ps(vx, impact)),
+                                                  _mm256_mul_ps(vx, _mm256_sub_ps(dt, impact)));
+                bx = select8(flip, reflectedX, bx);
+                dx = _mm256_xor_ps(dx, _mm256_and_ps(flip, signBit));
+                _mm256_storeu_si256((__m256i*)(l.lastHit[s] + i),
+                                    _mm256_and_si256(_mm256_castps_si256(hit), oneI));
+            }
+
+            __m256i leftGoal = _mm256_castps_si256(_mm256_cmp_ps(bx, negSize, _CMP_LT_OQ));
+            __m256i rightGoal = _mm256_castps_si256(_mm256_cmp_ps(bx, width, _CMP_GT_OQ));
+            __m256i goal = _mm256_or_si256(_mm256_and_si256(leftGoal, twoI),
+                                           _mm256_andnot_si256(leftGoal, _mm256_and_si256(rightGoal, oneI)));
+
+            _mm256_storeu_ps(l.ballX + i, bx);
+            _mm256_storeu_ps(l.ballY + i, by);
+            _mm256_storeu_ps(l.dirX + i, dx);
+            _mm256_storeu_ps(l.dirY + i, dy);
+            _mm256_storeu_si256((__m256i*)(l.scorer + i), goal);
+        }
+
+        for (int i = vecEnd; i < l.count; i++) {
+            stepLane(l, p, i);
+        }
+    }
+#endif
+
+    // Kernel for a given instruction set (falls back to scalar when the
+    // set is not compiled in)
+    inline PhysicsKernel get(SimdLevel level) {
+#if PONG_SIMD_X86
+        if (level == SimdLevel::AVX2) return stepAVX2;
+        if (level == SimdLevel::SSE2) return stepSSE2;
+#endif
+        return stepScalar;
+    }
+
+    // Widest kernel this CPU can run
+    inline PhysicsKernel best() {
+        return get(CpuFeatures::detect());
+    }
+}
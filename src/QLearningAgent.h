@@ -1,6 +1,11 @@
 #pragma once
 
+#include "AgentState.h"
 #include "NeuralNetwork.h"
+#include "FixedNetwork.h"
+#include "QuantizedNetwork.h"
+#include "ReplayBuffer.h"
+#include "Random.h"
 #include <deque>
 #include <random>
 #include <algorithm>
@@ -8,24 +13,25 @@
 
 using namespace std;
 
-struct Experience {
-    vector<float> state;
-    int action;
-    float reward;
-    vector<float> nextState;
-    bool done;
-    
-    Experience() : action(0), reward(0.0f), done(false) {}
-    
-    Experience(const vector<float>& s, int a, float r, const vector<float>& ns, bool d)
-        : state(s), action(a), reward(r), nextState(ns), done(d) {}
-};
+static_assert(AgentState::SIZE == ReplayBuffer::STATE_SIZE, "replay rows hold one AgentState");
 
 class QLearningAgent {
 private:
+    // Batches smaller than this are trained sample by sample
+    static const int MIN_MATRIX_BATCH = 16;
+    
+    // Prioritized replay: importance-sampling exponent, annealed from
+    // PRIORITY_BETA_START to 1 (full correction) over PRIORITY_BETA_BATCHES
+    static constexpr float PRIORITY_BETA_START = 0.4f;
+    static const int PRIORITY_BETA_BATCHES = 20000;
+    
     NeuralNetwork qNetwork;
-    deque<Experience> replayBuffer;
-    int maxBufferSize;
+    FixedPolicy policy;  // Compile-time sized copy of qNetwork for inference
+    QuantizedNetwork frozenNetwork;  // Quantized copy, built when training stops
+    bool quantizedInference;         // Use frozenNetwork while it is current
+    ReplayView replay;  // Own buffer, or a view of a population-shared one
+    bool sharedReplay;
+    float priorityBeta;
     
     float epsilon;
     float epsilonMin;
@@ -43,27 +49,60 @@ private:
     int recentWindowSize;  // Tamaño de la ventana para fitness
     float bestFitness;  // Mejor fitness alcanzado
     
-    random_device rd;
-    mt19937 gen;
-    uniform_real_distribution<float> dist;
+    RandomStream rng;  // Exploration and replay sampling (child of RandomSeeds)
+    
+    // Mini-batch scratch: sampled rows of the replay buffer, and their
+    // states / next-states stacked row by row for the matrix path
+    vector<int> batchIndices;
+    vector<float> batchWeights;  // Importance-sampling weights (prioritized replay)
+    vector<float> batchErrors;   // TD errors of the last batch, for new priorities
+    vector<float> batchStates;
+    vector<float> batchNextStates;
+    vector<int> batchActions;
+    vector<float> batchTargets;  // Rewards, then TD targets
+    vector<char> batchDone;
+    
+    // Pick random rows of the replay buffer into batchIndices (and their
+    // weights into batchWeights when prioritized)
+    int sampleBatch() {
+        int sampleSize = min(batchSize, replay.size());
+        batchIndices.resize(sampleSize);
+        if (replay->isPrioritized()) {
+            batchWeights.resize(sampleSize);
+            replay->samplePrioritized(sampleSize, priorityBeta, rng,
+                                      batchIndices.data(), batchWeights.data());
+            priorityBeta = min(1.0f, priorityBeta + (1.0f - PRIORITY_BETA_START) / PRIORITY_BETA_BATCHES);
+        } else {
+            replay.sampleIndices(sampleSize, rng, batchIndices.data());
+        }
+        return sampleSize;
+    }
     
-    // Sample random experiences from replay buffer
-    vector<Experience> sampleBatch() {
-        vector<Experience> batch;
-        int sampleSize = min(batchSize, (int)replayBuffer.size());
+    // Stack the sampled rows into the batch matrices
+    void gatherBatch(int count) {
+        const int inputSize = ReplayBuffer::STATE_SIZE;
+        batchStates.resize(count * inputSize);
+        batchNextStates.resize(count * inputSize);
+        batchActions.resize(count);
+        batchTargets.resize(count);
+        batchDone.resize(count);
         
-        for (int i = 0; i < sampleSize; i++) {
-            uniform_int_distribution<int> indexDist(0, replayBuffer.size() - 1);
-            batch.push_back(replayBuffer[indexDist(gen)]);
+        replay->decodeRows(batchIndices.data(), count, batchStates.data(), batchNextStates.data());
+        for (int i = 0; i < count; i++) {
+            int row = batchIndices[i];
+            batchActions[i] = replay->action(row);
+            batchTargets[i] = replay->reward(row);
+            batchDone[i] = replay->done(row);
         }
-        
-        return batch;
     }
     
 public:
     QLearningAgent(int inputSize = 6, int outputSize = 3, int hiddenSize = 12)
         : qNetwork(inputSize, hiddenSize, outputSize),
-          maxBufferSize(10000),
+          quantizedInference(false),
+          replay(make_shared<ReplayBuffer>(10000)),
+          sharedReplay(false),
+          priorityBeta(PRIORITY_BETA_START),
           epsilon(1.0f),
           epsilonMin(0.1f),
           epsilonDecay(0.98f),  // Decay más rápido (0.98 en lugar de 0.995)
@@ -78,15 +117,18 @@ public:
           bestWinRate(0.0f),
           recentWindowSize(10),  // Usar últimas 10 partidas para fitness
           bestFitness(0.0f),
-          gen(rd()),
-          dist(0.0f, 1.0f) {
+          rng(RandomSeeds::next()) {
+        policy.bind(qNetwork);
     }
     
     // Constructor with custom hyperparameters
     QLearningAgent(int inputSize, int outputSize, int hiddenSize, 
                    float lr, float epsilonDec, float discount, int batch)
         : qNetwork(inputSize, hiddenSize, outputSize),
-          maxBufferSize(10000),
+          quantizedInference(false),
+          replay(make_shared<ReplayBuffer>(10000)),
+          sharedReplay(false),
+          priorityBeta(PRIORITY_BETA_START),
           epsilon(1.0f),
           epsilonMin(0.1f),
           epsilonDecay(epsilonDec),
@@ -101,55 +143,167 @@ public:
           bestWinRate(0.0f),
           recentWindowSize(10),
           bestFitness(0.0f),
-          gen(rd()),
-          dist(0.0f, 1.0f) {
+          rng(RandomSeeds::next()) {
+        policy.bind(qNetwork);
     }
     
-    // Select action using epsilon-greedy policy
-    int selectAction(const vector<float>& state) {
-        uniform_real_distribution<float> randDist(0.0f, 1.0f);
+    // Start over as a new agent with other hyperparameters, reusing this
+    // object's storage: the network is re-initialized in place (buffers
+    // only grow), the own replay buffer is emptied but keeps its columns.
+    // The network and the agent take new streams from RandomSeeds in the
+    // same order as the constructor, so a seeded run gives a recycled agent
+    // the same weights and exploration as a new one. A shared replay view
+    // is kept.
+    void reinitialize(int hiddenSize, float lr, float epsilonDec, float discount, int batch) {
+        qNetwork.reseed();
+        rng = RandomSeeds::next();
+        
+        const vector<int>& sizes = qNetwork.getLayerSizes();
+        qNetwork.setLayerSizes({ sizes.front(), hiddenSize, sizes.back() });
+        qNetwork.initializeNetwork();
+        policy.bind(qNetwork);
+        quantizedInference = false;
+        
+        if (!sharedReplay) {
+            replay->clear();
+        }
+        priorityBeta = PRIORITY_BETA_START;
         
-        if (randDist(gen) < epsilon) {
+        epsilon = 1.0f;
+        epsilonDecay = epsilonDec;
+        learningRate = lr;
+        discountFactor = discount;
+        batchSize = batch;
+        frameCount = 0;
+        episodeCount = 0;
+        wins = 0;
+        totalGames = 0;
+        bestWinRate = 0.0f;
+        recentResults.clear();
+        bestFitness = 0.0f;
+    }
+    
+    // Best action for state (getLayerSizes()[0] values). Uses the
+    // FixedPolicy copy when it is up to date with the network, otherwise the
+    // generic network. Allocation-free for the usual network shapes.
+    int greedyAction(const float* state) const {
+        if (quantizedInference && frozenNetwork.isCurrent(qNetwork)) {
+            int outputSize = frozenNetwork.getLayerSizes().back();
+            float qValues[QuantizedNetwork::STACK_LAYER_WIDTH];
+            if (outputSize <= QuantizedNetwork::STACK_LAYER_WIDTH) {
+                frozenNetwork.predictQValuesInto(state, qValues);
+                return max_element(qValues, qValues + outputSize) - qValues;
+            }
+        }
+        if (policy.isCurrent(qNetwork)) {
+            float qValues[FixedPolicy::OUTPUTS];
+            policy.predict(state, qValues);
+            return max_element(qValues, qValues + FixedPolicy::OUTPUTS) - qValues;
+        }
+        int outputSize = qNetwork.getLayerSizes().back();
+        float qValues[NeuralNetwork::STACK_LAYER_WIDTH];
+        if (outputSize > NeuralNetwork::STACK_LAYER_WIDTH) {
+            vector<float> wide(outputSize);
+            qNetwork.predictQValuesInto(state, wide.data());
+            return max_element(wide.begin(), wide.end()) - wide.begin();
+        }
+        qNetwork.predictQValuesInto(state, qValues);
+        return max_element(qValues, qValues + outputSize) - qValues;
+    }
+    
+    // Reload the FixedPolicy copy after the network changed (training,
+    // loading a model). selectAction(state) does it on its own; call this
+    // before sharing the agent read-only between threads.
+    void syncPolicy() {
+        if (!policy.isCurrent(qNetwork)) {
+            policy.bind(qNetwork);
+        }
+    }
+    
+    // Select action using epsilon-greedy policy
+    int selectAction(const float* state) {
+        if (rng.nextFloat() < epsilon) {
             // Explore: random action
-            uniform_int_distribution<int> actionDist(0, 2);
-            return actionDist(gen);
+            return rng.nextInt(3);
         } else {
             // Exploit: best action according to Q-network
-            vector<float> qValues = qNetwork.getQValues(state);
-            return max_element(qValues.begin(), qValues.end()) - qValues.begin();
+            syncPolicy();
+            return greedyAction(state);
         }
     }
     
-    // Store experience in replay buffer
-    void remember(const Experience& exp) {
-        replayBuffer.push_back(exp);
-        if (replayBuffer.size() > maxBufferSize) {
-            replayBuffer.pop_front();
+    // Epsilon-greedy with the match's random stream. Does not touch the agent,
+    // so tournament workers can query the same agent concurrently.
+    int selectAction(const float* state, RandomStream& rng) const {
+        if (rng.nextFloat() < epsilon) {
+            // Explore: random action
+            return rng.nextInt(3);
+        } else {
+            // Exploit: best action according to Q-network
+            return greedyAction(state);
         }
     }
     
+    // Store a transition in the replay buffer (overwrites the oldest when full)
+    void remember(const AgentState& state, int action, float reward,
+                  const AgentState& nextState, bool done) {
+        replay->push(state.data(), action, reward, nextState.data(), done);
+    }
+    
     // Train the network using experience replay
     void train(int numBatches = 1) {
-        if (replayBuffer.size() < batchSize) {
+        if (replay.size() < batchSize) {
             return;
         }
         
         // Entrenar múltiples batches para aprendizaje más efectivo
         for (int batch = 0; batch < numBatches; batch++) {
-            vector<Experience> experienceBatch = sampleBatch();
+            int count = sampleBatch();
+            int outputSize = qNetwork.getLayerSizes().back();
+            bool prioritized = replay->isPrioritized();
             
-            for (const auto& exp : experienceBatch) {
-                vector<float> currentQValues = qNetwork.getQValues(exp.state);
-                float targetQ = exp.reward;
-                
-                if (!exp.done) {
-                    vector<float> nextQValues = qNetwork.getQValues(exp.nextState);
-                    float maxNextQ = *max_element(nextQValues.begin(), nextQValues.end());
-                    targetQ += discountFactor * maxNextQ;
+            // Tiny batches: fused per-sample steps beat setting up the matrices
+            if (count < MIN_MATRIX_BATCH) {
+                AgentState state, nextState;
+                for (int i = 0; i < count; i++) {
+                    int row = batchIndices[i];
+                    replay->decode(row, state.values, nextState.values);
+                    float rate = prioritized ? learningRate * batchWeights[i] : learningRate;
+                    float tdError = qNetwork.trainStep(state.data(), replay->action(row),
+                                                       replay->reward(row), nextState.data(),
+                                                       replay->done(row), discountFactor, rate);
+                    if (prioritized) {
+                        replay->updatePriority(row, tdError);
+                    }
                 }
-                
-                // Update Q-value for the action taken
-                qNetwork.updateQValue(exp.state, exp.action, targetQ, learningRate);
+                continue;
+            }
+            
+            gatherBatch(count);
+            
+            // Targets: r + gamma * max_a' Q(s', a') for non-terminal samples
+            const float* nextQValues = qNetwork.forwardBatch(batchNextStates.data(), count);
+            for (int i = 0; i < count; i++) {
+                if (!batchDone[i]) {
+                    float maxNextQ = nextQValues[i];
+                    for (int a = 1; a < outputSize; a++) {
+                        maxNextQ = max(maxNextQ, nextQValues[a * count + i]);
+                    }
+                    batchTargets[i] += discountFactor * maxNextQ;
+                }
+            }
+            
+            // Forward the states and apply one accumulated update for the batch
+            qNetwork.forwardBatch(batchStates.data(), count);
+            if (prioritized) {
+                batchErrors.resize(count);
+                qNetwork.backwardBatch(batchActions.data(), batchTargets.data(), learningRate,
+                                       batchWeights.data(), batchErrors.data());
+                for (int i = 0; i < count; i++) {
+                    replay->updatePriority(batchIndices[i], batchErrors[i]);
+                }
+            } else {
+                qNetwork.backwardBatch(batchActions.data(), batchTargets.data(), learningRate);
             }
         }
     }
@@ -169,14 +323,14 @@ public:
     // Update and train (called each frame)
     void update() {
         frameCount++;
-        if (frameCount % updateFrequency == 0 && replayBuffer.size() >= batchSize) {
+        if (frameCount % updateFrequency == 0 && replay.size() >= batchSize) {
             train(1);  // Entrenar 1 batch cada updateFrequency frames
         }
     }
     
     // Entrenar después de un episodio (llamar después de cada partida)
     void trainAfterEpisode() {
-        if (replayBuffer.size() >= batchSize) {
+        if (replay.size() >= batchSize) {
             // Entrenar múltiples batches después de cada partida
             train(5);  // 5 batches de entrenamiento después de cada partida
             decayEpsilonAfterEpisode();
@@ -274,11 +428,35 @@ public:
     }
     
     int getReplayBufferSize() const {
-        return replayBuffer.size();
+        return replay.size();
+    }
+    
+    // Sample transitions by TD error instead of uniformly (see ReplayBuffer).
+    // Off by default.
+    void setPrioritizedReplay(bool enabled) {
+        replay->setPrioritized(enabled);
+        priorityBeta = PRIORITY_BETA_START;
+    }
+    
+    bool isPrioritizedReplay() const {
+        return replay->isPrioritized();
+    }
+    
+    // Store and sample transitions through view (e.g. a population-wide
+    // buffer) instead of the agent's own buffer
+    void setReplayView(const ReplayView& view) {
+        replay = view;
+        sharedReplay = true;
+    }
+    
+    const ReplayView& getReplayView() const {
+        return replay;
     }
     
     // Calculate reward based on game state
-    float calculateReward(const vector<float>& prevState, const vector<float>& currentState,
+    // State is vector<float> or AgentState
+    template<typename State>
+    float calculateReward(const State& prevState, const State& currentState,
                          bool hitBall, bool missedBall, bool scored, bool opponentScored) {
         float reward = 0.0f;
         
@@ -376,6 +554,10 @@ public:
     void setTrainingEnabled(bool enabled) {
         if (!enabled) {
             epsilon = epsilonMin;  // Stop exploration when not training
+            syncPolicy();  // Weights are frozen from here on
+            if (quantizedInference) {
+                frozenNetwork.freeze(qNetwork);
+            }
         } else {
             // Si se habilita el entrenamiento, asegurar que epsilon no esté en mínimo
             if (epsilon <= epsilonMin) {
@@ -384,6 +566,18 @@ public:
         }
     }
     
+    // Play with the int8-quantized frozen network whenever training is
+    // disabled (see QuantizedNetwork). Off by default: for the 6-N-3 agent
+    // networks FixedPolicy is faster, quantization only pays off for wider
+    // layers. Takes effect the next time training is disabled.
+    void setQuantizedInference(bool enabled) {
+        quantizedInference = enabled;
+    }
+    
+    bool isQuantizedInference() const {
+        return quantizedInference;
+    }
+    
     // Get network for saving/loading
     NeuralNetwork& getNetwork() {
         return qNetwork;
@@ -410,6 +604,13 @@ public:
     void copyTo(QLearningAgent& target) const {
         // Copy network weights
         qNetwork.copyTo(target.qNetwork);
+        target.syncPolicy();
+        
+        // The copy joins a shared replay buffer (no transitions are copied);
+        // an own buffer stays with this agent
+        if (sharedReplay) {
+            target.setReplayView(replay);
+        }
         
         // Copy other important state
         target.epsilon = this->epsilon;
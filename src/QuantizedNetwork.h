@@ -0,0 +1,247 @@
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "CpuFeatures.h"
+#include "AlignedAllocator.h"
+#include <cstdint>
+#include <cmath>
+
+using namespace std;
+
+// Integer matrix-vector products for QuantizedNetwork: for each of
+// outputSize rows of w (stride 16-bit values apart), sums[row] = w[row] . x
+// with 32-bit accumulation (pmaddwd). stride is a multiple of QUANTIZED_LANES.
+typedef void (*QuantizedLayerKernel)(const int16_t* w, const int16_t* x, int stride,
+                                     int outputSize, int32_t* sums);
+
+const int QUANTIZED_LANES = 16;
+
+namespace QuantizedKernels {
+    inline void layerScalar(const int16_t* w, const int16_t* x, int stride,
+                            int outputSize, int32_t* sums) {
+        for (int neuron = 0; neuron < outputSize; neuron++) {
+            const int16_t* row = w + neuron * stride;
+            int32_t sum = 0;
+            for (int i = 0; i < stride; i++) {
+                sum += (int32_t)row[i] * x[i];
+            }
+            sums[neuron] = sum;
+        }
+    }
+
+#if PONG_SIMD_X86
+    __attribute__((target("sse2")))
+    inline int32_t hsumEpi32(__m128i v) {
+        v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0x4E));
+        v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0xB1));
+        return _mm_cvtsi128_si32(v);
+    }
+
+    __attribute__((target("sse2")))
+    inline void layerSSE2(const int16_t* w, const int16_t* x, int stride,
+                          int outputSize, int32_t* sums) {
+        for (int neuron = 0; neuron < outputSize; neuron++) {
+            const int16_t* row = w + neuron * stride;
+            __m128i acc = _mm_setzero_si128();
+            for (int i = 0; i < stride; i += 8) {
+                __m128i vw = _mm_load_si128((const __m128i*)(row + i));
+                __m128i vx = _mm_load_si128((const __m128i*)(x + i));
+                acc = _mm_add_epi32(acc, _mm_madd_epi16(vw, vx));
+            }
+            sums[neuron] = hsumEpi32(acc);
+        }
+    }
+
+    __attribute__((target("avx2")))
+    inline void layerAVX2(const int16_t* w, const int16_t* x, int stride,
+                          int outputSize, int32_t* sums) {
+        for (int neuron = 0; neuron < outputSize; neuron++) {
+            const int16_t* row = w + neuron * stride;
+            __m256i acc = _mm256_setzero_si256();
+            for (int i = 0; i < stride; i += 16) {
+                __m256i vw = _mm256_load_si256((const __m256i*)(row + i));
+                __m256i vx = _mm256_load_si256((const __m256i*)(x + i));
+                acc = _mm256_add_epi32(acc, _mm256_madd_epi16(vw, vx));
+            }
+            sums[neuron] = hsumEpi32(_mm_add_epi32(_mm256_castsi256_si128(acc),
+                                                   _mm256_extracti128_si256(acc, 1)));
+        }
+    }
+#endif
+
+    inline QuantizedLayerKernel get(SimdLevel level) {
+#if PONG_SIMD_X86
+        if (level == SimdLevel::AVX2) return layerAVX2;
+        if (level == SimdLevel::SSE2) return layerSSE2;
+#endif
+        return layerScalar;
+    }
+}
+
+// Frozen, inference-only copy of a NeuralNetwork with quantized weights.
+// Each layer's weights are rounded to int8 precision (+-127) with one scale
+// per layer; activations are rounded to int16 with one scale per vector,
+// computed on the fly. Products are summed exactly in 32-bit integers (no
+// overflow below ~500 inputs per neuron) and converted back to
+// float once per neuron, where the bias is added. Rows are zero-padded to
+// 16 lanes so the SIMD kernels need no tail handling.
+//
+// Used while an agent is not learning (tournaments, player-vs-AI without
+// training): QLearningAgent freezes it when training is disabled and drops
+// back to the float network as soon as the weights change.
+class QuantizedNetwork {
+public:
+    static const int WEIGHT_LEVELS = 127;
+    static const int ACTIVATION_LEVELS = 32767;
+    static const int STACK_LAYER_WIDTH = 64;  // Wider layers fall back to the heap
+
+private:
+    typedef vector<int16_t, AlignedAllocator<int16_t>> AlignedInt16s;
+
+    vector<int> layerSizes;
+    vector<int> strides;        // Padded input length of each layer
+    vector<int> weightOffsets;
+    vector<int> biasOffsets;
+    vector<float> weightScales;
+    AlignedInt16s weights;      // weights[weightOffsets[layer] + neuron * strides[layer] + input]
+    vector<float> biases;
+    int widestLayer;            // Padded, over inputs and outputs of every layer
+    QuantizedLayerKernel kernel;
+    bool frozen;
+    unsigned long version;      // NeuralNetwork version the weights came from
+
+    static int padded(int size) {
+        return (size + QUANTIZED_LANES - 1) / QUANTIZED_LANES * QUANTIZED_LANES;
+    }
+
+    // Round to nearest (halves away from zero) without a libm call
+    static int roundToInt(float x) {
+        return (int)(x + (x < 0.0f ? -0.5f : 0.5f));
+    }
+    
+    // Round values to int16 with a shared scale; returns that scale
+    static float quantizeActivations(const float* values, int size, int16_t* out, int paddedSize) {
+        float maxAbs = 0.0f;
+        for (int i = 0; i < size; i++) {
+            maxAbs = max(maxAbs, fabs(values[i]));
+        }
+        float scale = (maxAbs > 0.0f) ? maxAbs / ACTIVATION_LEVELS : 1.0f;
+        float inverse = 1.0f / scale;
+        for (int i = 0; i < size; i++) {
+            out[i] = (int16_t)roundToInt(values[i] * inverse);
+        }
+        for (int i = size; i < paddedSize; i++) {
+            out[i] = 0;
+        }
+        return scale;
+    }
+
+    void run(const float* input, float* out, int16_t* quantized, int32_t* sums, float* layerOutput) const {
+        int numLayers = layerSizes.size() - 1;
+        const float* layerInput = input;
+
+        for (int layer = 0; layer < numLayers; layer++) {
+            int inputSize = layerSizes[layer];
+            int outputSize = layerSizes[layer + 1];
+            int stride = strides[layer];
+            float inputScale = quantizeActivations(layerInput, inputSize, quantized, stride);
+            float scale = inputScale * weightScales[layer];
+            const int16_t* w = &weights[weightOffsets[layer]];
+            const float* b = &biases[biasOffsets[layer]];
+            bool hidden = layer < numLayers - 1;
+            float* z = hidden ? layerOutput : out;
+
+            kernel(w, quantized, stride, outputSize, sums);
+            for (int neuron = 0; neuron < outputSize; neuron++) {
+                float value = sums[neuron] * scale + b[neuron];
+                z[neuron] = hidden ? max(0.0f, value) : value;
+            }
+            layerInput = layerOutput;
+        }
+    }
+
+public:
+    QuantizedNetwork()
+        : widestLayer(0), kernel(QuantizedKernels::get(CpuFeatures::detect())),
+          frozen(false), version(0) {}
+
+    // Quantize network's current parameters
+    void freeze(const NeuralNetwork& network) {
+        layerSizes = network.getLayerSizes();
+        int numLayers = layerSizes.size() - 1;
+        strides.resize(numLayers);
+        weightOffsets.resize(numLayers);
+        biasOffsets.resize(numLayers);
+        weightScales.resize(numLayers);
+
+        int weightCount = 0;
+        int biasCount = 0;
+        widestLayer = 0;
+        for (int layer = 0; layer < numLayers; layer++) {
+            strides[layer] = padded(layerSizes[layer]);
+            weightOffsets[layer] = weightCount;
+            biasOffsets[layer] = biasCount;
+            weightCount += strides[layer] * layerSizes[layer + 1];
+            biasCount += layerSizes[layer + 1];
+            widestLayer = max(widestLayer, max(strides[layer], padded(layerSizes[layer + 1])));
+        }
+        weights.assign(weightCount, 0);
+        biases.assign(network.biasData(), network.biasData() + biasCount);
+
+        const float* source = network.weightData();
+        for (int layer = 0; layer < numLayers; layer++) {
+            int inputSize = layerSizes[layer];
+            int outputSize = layerSizes[layer + 1];
+            int count = inputSize * outputSize;
+
+            float maxAbs = 0.0f;
+            for (int i = 0; i < count; i++) {
+                maxAbs = max(maxAbs, fabs(source[i]));
+            }
+            float scale = (maxAbs > 0.0f) ? maxAbs / WEIGHT_LEVELS : 1.0f;
+            weightScales[layer] = scale;
+
+            for (int neuron = 0; neuron < outputSize; neuron++) {
+                int16_t* row = &weights[weightOffsets[layer] + neuron * strides[layer]];
+                for (int i = 0; i < inputSize; i++) {
+                    row[i] = (int16_t)roundToInt(source[neuron * inputSize + i] / scale);
+                }
+            }
+            source += count;
+        }
+
+        version = network.getVersion();
+        frozen = true;
+    }
+
+    // True when this frozen copy still matches network's weights
+    bool isCurrent(const NeuralNetwork& network) const {
+        return frozen && version == network.getVersion();
+    }
+
+    const vector<int>& getLayerSizes() const { return layerSizes; }
+
+    // Force a narrower dot-product kernel (e.g. Scalar to compare results)
+    void setSimdLevel(SimdLevel level) {
+        if (level > CpuFeatures::detect()) {
+            level = CpuFeatures::detect();
+        }
+        kernel = QuantizedKernels::get(level);
+    }
+
+    // Raw Q-values for input (layerSizes[0] values). Read-only, so threads
+    // can share one frozen network; allocation-free up to STACK_LAYER_WIDTH.
+    void predictQValuesInto(const float* input, float* out) const {
+        if (widestLayer <= STACK_LAYER_WIDTH) {
+            alignas(32) int16_t quantized[STACK_LAYER_WIDTH];
+            int32_t sums[STACK_LAYER_WIDTH];
+            float layerOutput[STACK_LAYER_WIDTH];
+            run(input, out, quantized, sums, layerOutput);
+        } else {
+            AlignedInt16s quantized(widestLayer);
+            vector<int32_t> sums(widestLayer);
+            vector<float> layerOutput(widestLayer);
+            run(input, out, quantized.data(), sums.data(), layerOutput.data());
+        }
+    }
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <atomic>
+
+using namespace std;
+
+// Small, fast random stream (PCG32: 64-bit LCG state, permuted 32-bit output).
+// Every match owns one, derived from the tournament seed and its pairing
+// index, so results do not depend on which thread plays the match and no
+// global generator (rand) is shared. Satisfies UniformRandomBitGenerator,
+// so it also works with the <random> distributions.
+class RandomStream {
+private:
+    uint64_t state;
+    uint64_t increment;  // Selects the stream; always odd
+
+public:
+    typedef uint32_t result_type;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    RandomStream(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t stream = 0) {
+        reseed(seed, stream);
+    }
+
+    // Streams with the same seed and different stream ids never overlap
+    void reseed(uint64_t seed, uint64_t stream) {
+        state = 0;
+        increment = (stream << 1) | 1;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+        uint32_t rot = (uint32_t)(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    result_type operator()() { return next(); }
+
+    // Uniform in [0, 1)
+    float nextFloat() {
+        return (next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Uniform in [0, n) (multiply-shift, bias is negligible for small n)
+    int nextInt(int n) {
+        return (int)(((uint64_t)next() * (uint32_t)n) >> 32);
+    }
+
+    bool nextBool() {
+        return (next() >> 31) != 0;
+    }
+
+    // Hash two values into a seed (SplitMix64 finalizer)
+    static uint64_t mix(uint64_t a, uint64_t b) {
+        uint64_t z = a + 0x9e3779b97f4a7c15ULL * (b + 1);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Non-reproducible seed for interactive play
+    static uint64_t entropySeed() {
+        random_device rd;
+        return ((uint64_t)rd() << 32) ^ rd();
+    }
+};
+
+// Root of the streams owned by networks, agents and populations. Each takes
+// the next child of one root seed: a counter increment and a hash instead
+// of a random_device read and 2.5 KB of mt19937 state per object. The root
+// comes from the OS on first use unless set (TournamentConfig::seed sets
+// it), so a seeded run gives every object the same stream again.
+class RandomSeeds {
+private:
+    struct Root {
+        atomic<uint64_t> seed;
+        atomic<uint64_t> children;
+
+        Root() : seed(RandomStream::entropySeed()), children(0) {}
+    };
+
+    static Root& root() {
+        static Root instance;
+        return instance;
+    }
+
+public:
+    // Restart the hierarchy: children are numbered again from 0
+    static void setRoot(uint64_t seed) {
+        root().seed = seed;
+        root().children = 0;
+    }
+
+    static uint64_t getRoot() {
+        return root().seed;
+    }
+
+    // Seed for the next child (e.g. a tournament's match seed)
+    static uint64_t nextSeed() {
+        Root& r = root();
+        return RandomStream::mix(r.seed, r.children++);
+    }
+
+    // Stream for the next child object
+    static RandomStream next() {
+        Root& r = root();
+        uint64_t child = r.children++;
+        return RandomStream(RandomStream::mix(r.seed, child), child);
+    }
+};
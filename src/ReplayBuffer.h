@@ -0,0 +1,436 @@
+#pragma once
+
+#include "CpuFeatures.h"
+#include "Random.h"
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// Binary tree of partial sums over non-negative leaf values: setting a leaf
+// and finding the leaf a cumulative value falls in are both O(log n).
+// Leaves sit at nodes[leafCount + i]; every inner node holds the sum of its
+// two children (recomputed, not adjusted, so rounding never accumulates).
+class SumTree {
+private:
+    int leafCount;  // Power of two
+    vector<float> nodes;
+
+public:
+    SumTree() : leafCount(0) {}
+
+    void reset(int size) {
+        leafCount = 1;
+        while (leafCount < size) {
+            leafCount *= 2;
+        }
+        nodes.assign(2 * leafCount, 0.0f);
+    }
+
+    float total() const { return nodes.empty() ? 0.0f : nodes[1]; }
+    float get(int leaf) const { return nodes[leafCount + leaf]; }
+
+    void set(int leaf, float value) {
+        int node = leafCount + leaf;
+        nodes[node] = value;
+        for (node /= 2; node >= 1; node /= 2) {
+            nodes[node] = nodes[2 * node] + nodes[2 * node + 1];
+        }
+    }
+
+    // Leaf whose cumulative range contains value (0 <= value < total()).
+    // Never descends into an empty subtree, even when rounding puts value
+    // past the last non-zero leaf.
+    int find(float value) const {
+        int node = 1;
+        while (node < leafCount) {
+            int left = 2 * node;
+            if (value < nodes[left] || nodes[left + 1] <= 0.0f) {
+                node = left;
+            } else {
+                value -= nodes[left];
+                node = left + 1;
+            }
+        }
+        return node - leafCount;
+    }
+};
+
+// Frame decoding for ReplayBuffer: STATE_SIZE 16-bit fixed-point features
+// to floats. Frames are read 8 values at a time, so the frame column carries
+// FRAME_PADDING spare values after the last frame.
+typedef void (*FrameDecoder)(const int16_t* frame, float* out);
+
+const int REPLAY_STATE_SIZE = 6;
+const float REPLAY_STATE_SCALE = 16384.0f;  // Fixed-point step 1/16384, range [-2, 2)
+
+namespace ReplayCodec {
+    inline void decodeScalar(const int16_t* frame, float* out) {
+        const float step = 1.0f / REPLAY_STATE_SCALE;
+        for (int i = 0; i < REPLAY_STATE_SIZE; i++) {
+            out[i] = frame[i] * step;
+        }
+    }
+
+#if PONG_SIMD_X86
+    __attribute__((target("sse2")))
+    inline void decodeSSE2(const int16_t* frame, float* out) {
+        const __m128 step = _mm_set1_ps(1.0f / REPLAY_STATE_SCALE);
+        __m128i v = _mm_loadu_si128((const __m128i*)frame);
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);  // Sign-extend
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(out, _mm_mul_ps(_mm_cvtepi32_ps(lo), step));
+        _mm_storel_pi((__m64*)(out + 4), _mm_mul_ps(_mm_cvtepi32_ps(hi), step));
+    }
+#endif
+
+    inline FrameDecoder get(SimdLevel level) {
+#if PONG_SIMD_X86
+        if (level >= SimdLevel::SSE2) return decodeSSE2;
+#endif
+        return decodeScalar;
+    }
+}
+
+// Fixed-capacity circular replay memory, stored compactly.
+// The ring holds entries of 20 bytes in separate columns: a frame (one
+// state as STATE_SIZE 16-bit fixed-point values), the reward, a flags byte
+// (action, done, and whether the entry is a transition), a back-reference
+// and a generation tag. A transition entry's frame is its next state; its
+// state is the frame stateOffset entries earlier (0 = its own frame). When
+// an agent's transitions chain, or repeat the same state for a few frames,
+// every push writes one entry; otherwise the state is written first as a
+// frame-only entry. When full, the oldest entry is overwritten. Sampling
+// hands out indices of transition entries; decodeRows expands them to
+// floats with the widest FrameDecoder the CPU supports.
+//
+// Entries are tagged with the generation they were pushed in
+// (beginGeneration), so one buffer can serve a whole population: the
+// entries of the last few generations are always the most recent stretch
+// of the ring.
+//
+// With priorities enabled, transitions are sampled proportionally to
+// (|TD error| + PRIORITY_EPSILON)^PRIORITY_ALPHA through a SumTree, new ones
+// get the highest priority seen so far, and the sampler also returns
+// importance-sampling weights that undo the bias (prioritized replay).
+class ReplayBuffer {
+public:
+    static constexpr int STATE_SIZE = REPLAY_STATE_SIZE;
+    static constexpr int FRAME_PADDING = 2;
+    static constexpr int MAX_STATE_OFFSET = 255;
+    static constexpr int MAX_SAMPLE_ATTEMPTS = 64;
+    static constexpr float PRIORITY_ALPHA = 0.6f;     // 0 = uniform, 1 = fully proportional
+    static constexpr float PRIORITY_EPSILON = 0.01f;  // Keeps zero-error rows sampleable
+
+private:
+    // flags bits
+    static constexpr uint8_t ACTION_MASK = 0x03;
+    static constexpr uint8_t DONE_FLAG = 0x04;
+    static constexpr uint8_t TRANSITION_FLAG = 0x08;
+
+    int capacity;
+    int count;  // Stored entries (<= capacity)
+    int head;   // Entry the next write goes to
+
+    vector<int16_t> frames;  // frames[row * STATE_SIZE + feature]
+    vector<float> rewards;
+    vector<uint8_t> flags;
+    vector<uint8_t> stateOffsets;
+    vector<uint16_t> generations;
+    FrameDecoder decoder;
+
+    int currentGeneration;
+    long long totalPushed;               // Entries written since creation (or clear)
+    vector<long long> generationStarts;  // totalPushed when each generation began
+    long long lastStateEntry;            // totalPushed of the frame holding the last state (-1 = none)
+
+    bool prioritized;
+    SumTree priorities;
+    float maxPriority;  // Given to new transitions so each is replayed at least once
+
+    static void encode(const float* state, int16_t* frame) {
+        for (int i = 0; i < STATE_SIZE; i++) {
+            float scaled = state[i] * REPLAY_STATE_SCALE;
+            scaled = max(-32768.0f, min(32767.0f, scaled));
+            frame[i] = (int16_t)(scaled + (scaled < 0.0f ? -0.5f : 0.5f));
+        }
+    }
+
+    int rowOf(long long entry) const {
+        return (int)(entry % capacity);
+    }
+
+    bool frameEquals(long long entry, const int16_t* frame) const {
+        return memcmp(&frames[rowOf(entry) * STATE_SIZE], frame, STATE_SIZE * sizeof(int16_t)) == 0;
+    }
+
+    // Offset from the next entry back to a stored frame equal to frame
+    // that survives the next write, or -1
+    int findStateFrame(const int16_t* frame) const {
+        int maxOffset = min(MAX_STATE_OFFSET, capacity - 1);
+        if (lastStateEntry >= 0 && totalPushed - lastStateEntry <= maxOffset &&
+            frameEquals(lastStateEntry, frame)) {
+            return (int)(totalPushed - lastStateEntry);
+        }
+        if (count > 0 && maxOffset >= 1 && frameEquals(totalPushed - 1, frame)) {
+            return 1;
+        }
+        return -1;
+    }
+
+    void write(const int16_t* frame, float reward, uint8_t entryFlags, int stateOffset) {
+        memcpy(&frames[head * STATE_SIZE], frame, STATE_SIZE * sizeof(int16_t));
+        rewards[head] = reward;
+        flags[head] = entryFlags;
+        stateOffsets[head] = (uint8_t)stateOffset;
+        generations[head] = (uint16_t)currentGeneration;
+        if (prioritized) {
+            priorities.set(head, (entryFlags & TRANSITION_FLAG) ? maxPriority : 0.0f);
+        }
+
+        head = (head + 1 == capacity) ? 0 : head + 1;
+        if (count < capacity) {
+            count++;
+        }
+        totalPushed++;
+    }
+
+    // Transition whose state frame is still stored
+    bool sampleable(int row) const {
+        if (!(flags[row] & TRANSITION_FLAG)) return false;
+        int oldest = head - count;
+        if (oldest < 0) oldest += capacity;
+        int position = row - oldest;
+        if (position < 0) position += capacity;
+        return stateOffsets[row] <= position;
+    }
+
+    // Most recent entry: always a transition
+    int newestRow() const {
+        return head == 0 ? capacity - 1 : head - 1;
+    }
+
+public:
+    explicit ReplayBuffer(int maxSize)
+        : capacity(maxSize), count(0), head(0),
+          decoder(ReplayCodec::get(CpuFeatures::detect())),
+          currentGeneration(0), totalPushed(0), generationStarts(1, 0), lastStateEntry(-1),
+          prioritized(false), maxPriority(1.0f) {}
+
+    // Entries stored (transitions plus frame-only entries)
+    int size() const { return count; }
+    int getCapacity() const { return capacity; }
+    bool empty() const { return count == 0; }
+
+    // Bytes held by the columns
+    size_t memoryUsage() const {
+        return frames.capacity() * sizeof(int16_t) + rewards.capacity() * sizeof(float) +
+               flags.capacity() + stateOffsets.capacity() + generations.capacity() * sizeof(uint16_t);
+    }
+
+    void clear() {
+        count = 0;
+        head = 0;
+        totalPushed = 0;
+        lastStateEntry = -1;
+        generationStarts.assign(currentGeneration + 1, 0);
+        if (prioritized) {
+            priorities.reset(capacity);
+            maxPriority = 1.0f;
+        }
+    }
+
+    // Drop the stored transitions and change the capacity
+    void setCapacity(int maxSize) {
+        capacity = maxSize;
+        clear();
+        frames.clear();
+        rewards.clear();
+        flags.clear();
+        stateOffsets.clear();
+        generations.clear();
+    }
+
+    // Force a narrower frame decoder (e.g. Scalar to compare results)
+    void setSimdLevel(SimdLevel level) {
+        if (level > CpuFeatures::detect()) {
+            level = CpuFeatures::detect();
+        }
+        decoder = ReplayCodec::get(level);
+    }
+
+    // Tag entries written from now on with generation (non-decreasing)
+    void beginGeneration(int generation) {
+        if (generation <= currentGeneration) return;
+        currentGeneration = generation;
+        generationStarts.resize(generation + 1, totalPushed);
+    }
+
+    int getGeneration() const { return currentGeneration; }
+
+    // Stored entries written during generation firstGeneration or later
+    int rowsSince(int firstGeneration) const {
+        if (firstGeneration <= 0) return count;
+        if (firstGeneration > currentGeneration) return 0;
+        return (int)min<long long>(count, totalPushed - generationStarts[firstGeneration]);
+    }
+
+    // Switch prioritized sampling on or off. Transitions already stored
+    // start with equal priority.
+    void setPrioritized(bool enabled) {
+        if (enabled == prioritized) return;
+        prioritized = enabled;
+        if (enabled) {
+            priorities.reset(capacity);
+            maxPriority = 1.0f;
+            for (int row = 0; row < count; row++) {
+                priorities.set(row, (flags[row] & TRANSITION_FLAG) ? maxPriority : 0.0f);
+            }
+        } else {
+            priorities = SumTree();
+        }
+    }
+
+    bool isPrioritized() const { return prioritized; }
+
+    // Action must fit in two bits (the agent has three)
+    void push(const float* state, int action, float reward, const float* nextState, bool done) {
+        if (frames.empty()) {
+            // Allocated on first use: agents that never learn pay nothing
+            frames.resize(capacity * STATE_SIZE + FRAME_PADDING);
+            rewards.resize(capacity);
+            flags.resize(capacity);
+            stateOffsets.resize(capacity);
+            generations.resize(capacity);
+        }
+
+        int16_t stateFrame[STATE_SIZE];
+        int16_t nextFrame[STATE_SIZE];
+        encode(state, stateFrame);
+        encode(nextState, nextFrame);
+
+        int stateOffset;
+        if (memcmp(stateFrame, nextFrame, sizeof(stateFrame)) == 0) {
+            stateOffset = 0;
+            lastStateEntry = totalPushed;
+        } else {
+            stateOffset = findStateFrame(stateFrame);
+            if (stateOffset < 0) {
+                write(stateFrame, 0.0f, 0, 0);
+                stateOffset = 1;
+            }
+            lastStateEntry = totalPushed - stateOffset;
+        }
+
+        uint8_t entryFlags = TRANSITION_FLAG | (uint8_t)(action & ACTION_MASK) | (done ? DONE_FLAG : 0);
+        write(nextFrame, reward, entryFlags, stateOffset);
+    }
+
+    // Fill indices with n transitions drawn uniformly (with replacement)
+    // from the newest recentRows entries
+    void sampleRecent(int n, int recentRows, RandomStream& rng, int* indices) const {
+        for (int i = 0; i < n; i++) {
+            int row = newestRow();
+            for (int attempt = 0; attempt < MAX_SAMPLE_ATTEMPTS; attempt++) {
+                int candidate = head - 1 - rng.nextInt(recentRows);
+                if (candidate < 0) candidate += capacity;
+                if (sampleable(candidate)) {
+                    row = candidate;
+                    break;
+                }
+            }
+            indices[i] = row;
+        }
+    }
+
+    // Fill indices with n transitions drawn proportionally to their
+    // priority, one from each of n equal slices of the total (stratified),
+    // and weights with their importance-sampling weights (N * P(row))^-beta,
+    // scaled so the largest in the batch is 1. Requires setPrioritized(true).
+    void samplePrioritized(int n, float beta, RandomStream& rng, int* indices, float* weights) const {
+        float total = priorities.total();
+        float segment = total / n;
+        float maxWeight = 0.0f;
+        for (int i = 0; i < n; i++) {
+            float value = min((i + rng.nextFloat()) * segment, total);
+            int row = min(priorities.find(value), count - 1);
+            // Rare: a transition whose state frame was just overwritten
+            for (int attempt = 0; !sampleable(row); attempt++) {
+                if (attempt == MAX_SAMPLE_ATTEMPTS) {
+                    row = newestRow();
+                    break;
+                }
+                row = min(priorities.find(rng.nextFloat() * total), count - 1);
+            }
+            float probability = priorities.get(row) / total;
+            indices[i] = row;
+            weights[i] = pow(count * probability, -beta);
+            maxWeight = max(maxWeight, weights[i]);
+        }
+        for (int i = 0; i < n; i++) {
+            weights[i] /= maxWeight;
+        }
+    }
+
+    // New priority of a sampled transition from its latest TD error
+    void updatePriority(int row, float tdError) {
+        float priority = pow(fabs(tdError) + PRIORITY_EPSILON, PRIORITY_ALPHA);
+        priorities.set(row, priority);
+        maxPriority = max(maxPriority, priority);
+    }
+
+    // State and next state of one transition, as floats
+    void decode(int row, float* state, float* nextState) const {
+        int stateRow = row - stateOffsets[row];
+        if (stateRow < 0) stateRow += capacity;
+        decoder(&frames[stateRow * STATE_SIZE], state);
+        decoder(&frames[row * STATE_SIZE], nextState);
+    }
+
+    // decode for n transitions, stacked row by row (STATE_SIZE floats each)
+    void decodeRows(const int* rows, int n, float* states, float* nextStates) const {
+        for (int i = 0; i < n; i++) {
+            decode(rows[i], states + i * STATE_SIZE, nextStates + i * STATE_SIZE);
+        }
+    }
+
+    int action(int row) const { return flags[row] & ACTION_MASK; }
+    float reward(int row) const { return rewards[row]; }
+    bool done(int row) const { return (flags[row] & DONE_FLAG) != 0; }
+    int generation(int row) const { return generations[row]; }
+};
+
+// An agent's handle on a replay buffer: its own, or one shared by a whole
+// population. Copying a view shares the buffer, never the transitions.
+// With a generation window only rows of the buffer's last generationWindow
+// generations are sampled (prioritized sampling always covers the whole
+// buffer, whose priorities are shared by every view).
+class ReplayView {
+private:
+    shared_ptr<ReplayBuffer> buffer;
+    int generationWindow;  // 0 = every stored row
+
+    int firstGeneration() const {
+        return generationWindow > 0 ? buffer->getGeneration() - generationWindow + 1 : 0;
+    }
+
+public:
+    explicit ReplayView(shared_ptr<ReplayBuffer> replayBuffer, int window = 0)
+        : buffer(replayBuffer), generationWindow(window) {}
+
+    ReplayBuffer* operator->() const { return buffer.get(); }
+
+    // Rows this view can sample
+    int size() const {
+        if (buffer->isPrioritized()) return buffer->size();
+        return buffer->rowsSince(firstGeneration());
+    }
+
+    void sampleIndices(int n, RandomStream& rng, int* indices) const {
+        buffer->sampleRecent(n, size(), rng, indices);
+    }
+};
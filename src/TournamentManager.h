@@ -2,7 +2,12 @@
 
 #include "AIPopulation.h"
 #include "TournamentMatch.h"
+#include "BatchSimulator.h"
+#include "EventDrivenMatch.h"
 #include "ModelSaver.h"
+#include "Random.h"
+#include "LockFree.h"
+#include "MatchTelemetry.h"
 #include <vector>
 #include <string>
 #include <iostream>
@@ -12,6 +17,10 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <climits>
 
 using namespace std;
 
@@ -32,15 +41,24 @@ struct TournamentConfig {
     int populationSize;
     int maxGenerations;
     int pointsPerMatch;
-    float speedMultiplier;
+    float speedMultiplier;  // Playback speed of watched matches (simulated s per wall s)
     float elitePercent;
     float mutationRate;
     TournamentMode mode;
+    int workerThreads;  // Match workers per generation (0 = one per hardware thread)
+    int batchLanes;     // Matches each worker advances in lockstep (0 = one TournamentMatch at a time)
+    bool eventDriven;   // Jump between collisions/decisions instead of fixed steps (overrides batchLanes)
+    float timestep;     // Fixed physics step for headless matches (1/60 or 1/120 s)
+    float generationTimeBudget;  // Wall-clock seconds per generation (0 = no limit)
+    uint64_t seed;      // Tournament seed for match randomness (0 = new one per tournament)
+    bool quantizedInference;  // Play round-robin matches with int8-quantized networks
     
     TournamentConfig()
         : populationSize(16), maxGenerations(50), pointsPerMatch(7),
           speedMultiplier(10.0f), elitePercent(0.25f), mutationRate(0.1f),
-          mode(TournamentMode::Evolutionary) {}
+          mode(TournamentMode::Evolutionary), workerThreads(0), batchLanes(128), eventDriven(false),
+          timestep(TournamentMatch::BASE_TIMESTEP), generationTimeBudget(0.0f), seed(0),
+          quantizedInference(false) {}
 };
 
 struct GenerationStats {
@@ -56,12 +74,64 @@ struct GenerationStats {
           worstFitness(0.0f), bestIndividualId("0000"), avgWinRate(0.0f) {}
 };
 
+// Display copy of an individual (the fields the HUD shows)
+struct IndividualSummary {
+    string id;
+    float fitness;
+    int wins;
+    int losses;
+    float winRate;
+    
+    IndividualSummary() : fitness(0.0f), wins(0), losses(0), winRate(0.0f) {}
+};
+
+// What the render loop shows of a tournament running in the background,
+// published by the tournament thread (see TournamentManager::readSnapshot)
+struct TournamentSnapshot {
+    TournamentState state;
+    int currentGeneration;
+    int maxGenerations;
+    int currentMatch;       // Pairings claimed in the running generation
+    int totalMatches;
+    float progress;         // 0.0 to 1.0, including the running generation
+    string statusMessage;
+    float avgFitness;
+    float bestFitness;
+    float allTimeBestFitness;
+    bool hasChampion;
+    IndividualSummary champion;
+    string eta;
+    vector<IndividualSummary> top;  // Best first, up to TOP_COUNT
+    
+    static const int TOP_COUNT = 5;
+    
+    TournamentSnapshot()
+        : state(TournamentState::Idle), currentGeneration(0), maxGenerations(0),
+          currentMatch(0), totalMatches(0), progress(0.0f), statusMessage("Ready"),
+          avgFitness(0.0f), bestFitness(0.0f), allTimeBestFitness(0.0f), hasChampion(false) {}
+    
+    // Matches left in this generation and the ones after it
+    int remainingMatches() const {
+        if (state != TournamentState::Running && state != TournamentState::Paused) {
+            return 0;
+        }
+        int laterGenerations = max(0, maxGenerations - currentGeneration - 1);
+        return (totalMatches - currentMatch) + laterGenerations * totalMatches;
+    }
+};
+
+// Requests from the UI thread to a tournament running in the background
+enum class TournamentCommand {
+    Pause,
+    Resume,
+    Stop
+};
+
 class TournamentManager {
 private:
     AIPopulation* population;
-    TournamentMatch* match;
     TournamentConfig config;
-    TournamentState state;
+    atomic<TournamentState> state;  // Read by match workers (pause/stop)
     
     int windowWidth;
     int windowHeight;
@@ -88,6 +158,12 @@ private:
     AIIndividual previousTournamentWinner;
     bool hasPreviousWinner;
     
+    // Seed of the running tournament; every match derives its stream from it
+    uint64_t tournamentSeed;
+    
+    // Wall-clock limit of the round being played (see claimPairing)
+    chrono::steady_clock::time_point roundDeadline;
+    
     // ETA tracking
     sf::Clock etaClock;
     float totalElapsedTime;
@@ -95,31 +171,55 @@ private:
     vector<float> generationTimes;
     float estimatedTimeRemaining;
     
+    // Background mode: the tournament thread runs generations, the UI posts
+    // commands and reads snapshots; neither waits for the other
+    static constexpr int CONTROL_POLL_MS = 10;        // Paused tournament thread
+    static constexpr int SNAPSHOT_INTERVAL_MS = 16;   // Between snapshots while matches run
+    thread backgroundThread;
+    atomic<bool> backgroundRunning;
+    atomic<bool> stopRequested;  // Set by stopBackground(); cannot be dropped like a queued Stop
+    SpscQueue<TournamentCommand, 16> commands;
+    TripleBuffer<TournamentSnapshot> snapshots;
+    chrono::steady_clock::time_point lastSnapshot;
+    
+    // Per-match events for the HUD (one ring per match worker), and when
+    // each pairing of the running round was claimed
+    MatchTelemetryFeed telemetry;
+    vector<chrono::steady_clock::time_point> matchStartTimes;
+    
 public:
     TournamentManager(int width, int height)
-        : population(nullptr), match(nullptr), state(TournamentState::Idle),
+        : population(nullptr), state(TournamentState::Idle),
           windowWidth(width), windowHeight(height),
           currentGeneration(0), currentMatch(0), totalMatches(0),
           progress(0.0f), statusMessage("Ready"),
           allTimeBestFitness(0.0f), hasAllTimeBest(false),
-          hasPreviousWinner(false),
+          hasPreviousWinner(false), tournamentSeed(0),
           totalElapsedTime(0.0f), lastGenerationStartTime(0.0f), 
-          estimatedTimeRemaining(0.0f) {
+          estimatedTimeRemaining(0.0f), backgroundRunning(false), stopRequested(false) {
         
         population = new AIPopulation(config.populationSize);
-        match = new TournamentMatch(width, height, config.pointsPerMatch, false);
+        telemetry.setWorkerCount(getWorkerCount(INT_MAX));
     }
     
     ~TournamentManager() {
+        stopBackground();
         if (population) delete population;
-        if (match) delete match;
     }
     
     // Initialize tournament
     void initialize() {
+        stopBackground();
+        
         float x = windowWidth - 50;
         float y = windowHeight / 2;
         
+        // A seeded tournament also reproduces genes, weights and exploration
+        if (config.seed != 0) {
+            RandomSeeds::setRoot(config.seed);
+            population->reseed();
+        }
+        
         // Try to load previous tournament winner
         if (loadTournamentWinner(x, y)) {
             // Previous winner exists - create population based on mutations of winner
@@ -128,9 +228,10 @@ public:
             // Add previous winner to population with preserved stats
             auto& individuals = population->getIndividuals();
             // Replace first individual with previous winner (preserving stats)
-            AIIndividual winnerCopy = previousTournamentWinner;
+            AIIndividual winnerCopy = previousTournamentWinner.clone();
             winnerCopy.generation = 0;  // Reset generation for new tournament
-            individuals[0] = winnerCopy;
+            individuals[0] = move(winnerCopy);
+            population->shareReplay();
             
             cout << "Tournament initialized with previous winner " << previousTournamentWinner.id 
                  << " (Fitness: " << previousTournamentWinner.fitness << ")" << endl;
@@ -144,6 +245,8 @@ public:
         
         currentGeneration = 0;
         currentMatch = 0;
+        progress = 0.0f;
+        tournamentSeed = (config.seed != 0) ? config.seed : RandomSeeds::nextSeed();
         statsHistory.clear();
         allTimeBestFitness = 0.0f;
         hasAllTimeBest = false;
@@ -158,16 +261,13 @@ public:
     
     // Set configuration
     void setConfig(const TournamentConfig& cfg) {
+        stopBackground();
         config = cfg;
         if (population) {
             delete population;
             population = new AIPopulation(config.populationSize);
         }
-        if (match) {
-            delete match;
-            match = new TournamentMatch(windowWidth, windowHeight, 
-                                       config.pointsPerMatch, false);
-        }
+        telemetry.setWorkerCount(getWorkerCount(INT_MAX));
     }
     
     // Start tournament
@@ -212,6 +312,50 @@ public:
         statusMessage = "Tournament stopped";
     }
     
+    // Start the tournament on its own thread. Until it finishes, the caller
+    // must only use post(), readSnapshot(), isBackgroundRunning() and
+    // stopBackground(): the population belongs to the tournament thread.
+    void startBackground() {
+        stopBackground();
+        TournamentCommand stale;
+        while (commands.pop(stale)) {}  // Left over from a finished run
+        
+        start();
+        publishSnapshot();
+        backgroundRunning = true;
+        backgroundThread = thread(&TournamentManager::runBackground, this);
+    }
+    
+    // True until the background tournament completes or stops
+    bool isBackgroundRunning() const {
+        return backgroundRunning;
+    }
+    
+    // Queue a command for the background tournament (applied between matches)
+    bool post(TournamentCommand command) {
+        return commands.push(command);
+    }
+    
+    // Stop the background tournament and wait for its thread. Matches in
+    // flight finish first; the interrupted generation is not evolved.
+    void stopBackground() {
+        if (backgroundThread.joinable()) {
+            stopRequested = true;  // Not post(): a full command queue would drop it
+            backgroundThread.join();
+            stopRequested = false;
+        }
+    }
+    
+    // Latest published progress (UI thread)
+    const TournamentSnapshot& readSnapshot() {
+        return snapshots.read();
+    }
+    
+    // Finished-match events, drained by the UI thread (see HUD)
+    MatchTelemetryFeed& getTelemetry() {
+        return telemetry;
+    }
+    
     // Run one generation (returns true if more generations to go)
     bool runGeneration() {
         if (currentGeneration >= config.maxGenerations) {
@@ -258,6 +402,11 @@ public:
         // Run tournament matches
         runRoundRobinTournament();
         
+        // Stopped mid-generation: partial results are not worth evolving on
+        if (state == TournamentState::Idle) {
+            return false;
+        }
+        
         // Restore and accumulate previous winner's historical stats
         if (hasPreviousWinner && prevWinnerFound) {
             auto& individuals = population->getIndividuals();
@@ -275,9 +424,8 @@ public:
             }
         }
         
-        // Calculate fitness
+        // Calculate fitness (the population ranks itself on demand)
         population->calculateAllFitness();
-        population->sortByFitness();
         
         // Integrate all-time champion into population if it exists and isn't already present
         // Do this after calculating fitness so we can replace worst individual if needed
@@ -296,14 +444,13 @@ public:
             // If champion not in population, replace worst individual with champion
             if (!championInPopulation && !individuals.empty()) {
                 // Create a copy of the champion
-                AIIndividual championCopy = allTimeBestIndividual;
+                AIIndividual championCopy = allTimeBestIndividual.clone();
                 championCopy.generation = currentGeneration;
                 // Reset stats so it competes fresh in next generation
                 championCopy.resetStats();
-                // Replace worst individual (last in sorted list)
-                individuals.back() = championCopy;
-                // Re-sort to maintain order
-                population->sortByFitness();
+                // Replace worst individual
+                population->replaceWorst(move(championCopy));
+                population->shareReplay();
             }
         }
         
@@ -322,14 +469,14 @@ public:
         stats.avgWinRate = totalWinRate / population->getSize();
         
         // Find worst fitness
-        stats.worstFitness = population->getIndividuals().back().fitness;
+        stats.worstFitness = population->getWorst().fitness;
         
         statsHistory.push_back(stats);
         
         // Check and update all-time best
         if (stats.bestFitness > allTimeBestFitness) {
             allTimeBestFitness = stats.bestFitness;
-            allTimeBestIndividual = population->getBest();  // Hace copia
+            allTimeBestIndividual = population->getBest().clone();
             hasAllTimeBest = true;
             // Progress output removed
         }
@@ -339,8 +486,8 @@ public:
         // Cache top individuals for display (before evolution resets stats)
         cachedTopIndividuals.clear();
         for (int i = 0; i < min(5, (int)population->getSize()); i++) {
-            const auto& ind = population->getIndividual(i);
-            cachedTopIndividuals.push_back(ind);
+            const auto& ind = population->getRanked(i);
+            cachedTopIndividuals.push_back(ind.clone());
         }
         
         // Save top models
@@ -364,13 +511,12 @@ public:
             
             // If champion not in new generation, replace worst individual with champion
             if (!championInNewGen) {
-                // Sort to find worst individual
-                population->sortByFitness();
                 // Replace the worst individual with the champion
-                AIIndividual championCopy = allTimeBestIndividual;
+                AIIndividual championCopy = allTimeBestIndividual.clone();
                 championCopy.generation = currentGeneration + 1;
                 championCopy.resetStats();  // Reset stats for new generation
-                individuals.back() = championCopy;
+                population->replaceWorst(move(championCopy));
+                population->shareReplay();
             }
         }
         
@@ -401,6 +547,7 @@ public:
             estimatedTimeRemaining = 0.0f;
         }
         
+        publishSnapshot();
         return currentGeneration < config.maxGenerations;
     }
     
@@ -428,52 +575,389 @@ public:
     }
     
 private:
+    // Tournament thread of startBackground()
+    void runBackground() {
+        while (true) {
+            applyCommands();
+            if (state == TournamentState::Running) {
+                if (!runGeneration()) {
+                    break;
+                }
+            } else if (state == TournamentState::Paused) {
+                publishSnapshot();
+                this_thread::sleep_for(chrono::milliseconds(CONTROL_POLL_MS));
+            } else {
+                break;
+            }
+        }
+        
+        if (state == TournamentState::Running) {
+            state = TournamentState::Completed;
+            statusMessage = "Tournament completed";
+            estimatedTimeRemaining = 0.0f;
+        }
+        publishSnapshot();
+        backgroundRunning = false;
+    }
+    
+    // Apply queued UI commands (tournament thread)
+    void applyCommands() {
+        TournamentCommand command;
+        while (commands.pop(command)) {
+            switch (command) {
+                case TournamentCommand::Pause:  pause();  break;
+                case TournamentCommand::Resume: resume(); break;
+                case TournamentCommand::Stop:   stop();   break;
+            }
+        }
+        if (stopRequested) {
+            stop();
+        }
+    }
+    
+    // Copy the display state into the snapshot buffer (tournament thread)
+    void publishSnapshot(int claimedMatches = -1) {
+        TournamentSnapshot& snapshot = snapshots.back();
+        snapshot.state = state;
+        snapshot.currentGeneration = currentGeneration;
+        snapshot.maxGenerations = config.maxGenerations;
+        snapshot.currentMatch = (claimedMatches >= 0) ? min(claimedMatches, totalMatches) : currentMatch;
+        snapshot.totalMatches = totalMatches;
+        snapshot.progress = progress;
+        if (claimedMatches >= 0 && totalMatches > 0 && config.maxGenerations > 0) {
+            snapshot.progress += (float)snapshot.currentMatch / totalMatches / config.maxGenerations;
+        }
+        snapshot.statusMessage = statusMessage;
+        if (claimedMatches >= 0 && state == TournamentState::Running) {
+            char matchStatus[64];
+            snprintf(matchStatus, sizeof(matchStatus), "Running - match %d / %d",
+                     snapshot.currentMatch, totalMatches);
+            snapshot.statusMessage = matchStatus;
+        }
+        snapshot.avgFitness = getCurrentAverageFitness();
+        snapshot.bestFitness = getLastBestFitness();
+        snapshot.allTimeBestFitness = allTimeBestFitness;
+        snapshot.hasChampion = hasAllTimeBest;
+        if (hasAllTimeBest) {
+            summarize(allTimeBestIndividual, snapshot.champion);
+        }
+        snapshot.eta = getFormattedETA();
+        
+        vector<AIIndividual*> top = getTopIndividuals(TournamentSnapshot::TOP_COUNT);
+        snapshot.top.resize(top.size());
+        for (size_t i = 0; i < top.size(); i++) {
+            summarize(*top[i], snapshot.top[i]);
+        }
+        
+        snapshots.publish();
+        lastSnapshot = chrono::steady_clock::now();
+    }
+    
+    static void summarize(const AIIndividual& individual, IndividualSummary& summary) {
+        summary.id = individual.id;
+        summary.fitness = individual.fitness;
+        summary.wins = individual.wins;
+        summary.losses = individual.losses;
+        summary.winRate = individual.winRate;
+    }
+    
+    // Commands and snapshots while matches run, from the controlling worker
+    void pollControl(int claimedMatches) {
+        applyCommands();
+        if (chrono::steady_clock::now() - lastSnapshot >= chrono::milliseconds(SNAPSHOT_INTERVAL_MS)) {
+            publishSnapshot(claimedMatches);
+        }
+    }
+    
+    // Number of match workers for a round of matchCount matches
+    int getWorkerCount(int matchCount) const {
+        int workers = config.workerThreads;
+        if (workers <= 0) {
+            workers = (int)thread::hardware_concurrency();
+        }
+        return max(1, min(workers, matchCount));
+    }
+    
+    // Double round-robin in rounds (circle method): in every round each
+    // individual plays once, and home/away alternate so that after any round
+    // nobody is more than one home match ahead. If the time budget ends the
+    // generation early, every individual has played about as many matches,
+    // against varied opponents, instead of the highest indices losing their
+    // home matches. The second half repeats the first with sides swapped.
+    static vector<pair<int, int>> roundRobinSchedule(int n) {
+        int slots = (n % 2 == 0) ? n : n + 1;  // Odd counts get a bye slot
+        vector<pair<int, int>> firstLeg;
+        for (int round = 0; round < slots - 1; round++) {
+            for (int k = 0; k < slots / 2; k++) {
+                int home, away;
+                if (k == 0) {
+                    home = round;
+                    away = slots - 1;  // Fixed slot, the others rotate
+                    if (round % 2 == 1) swap(home, away);
+                } else {
+                    home = (round + k) % (slots - 1);
+                    away = (round - k + slots - 1) % (slots - 1);
+                    if (k % 2 == 1) swap(home, away);
+                }
+                if (home >= n || away >= n) continue;  // Bye
+                firstLeg.push_back(make_pair(home, away));
+            }
+        }
+        
+        vector<pair<int, int>> pairings = firstLeg;
+        for (const auto& match : firstLeg) {
+            pairings.push_back(make_pair(match.second, match.first));
+        }
+        return pairings;
+    }
+    
     // Run round-robin tournament (all vs all)
+    // Pairings are pulled from a shared counter by a pool of workers, each with
+    // its own TournamentMatch. Results are stored per pairing and merged in
+    // pairing order afterwards, so the outcome does not depend on scheduling.
     void runRoundRobinTournament() {
         auto& individuals = population->getIndividuals();
         int n = individuals.size();
-        totalMatches = n * (n - 1);  // Each pair plays twice (home and away)
-        currentMatch = 0;
         
-        // Progress output removed
+        // Each individual plays against every other individual twice (home and away)
+        vector<pair<int, int>> pairings = roundRobinSchedule(n);
+        totalMatches = pairings.size();
+        currentMatch = 0;
         
-        // Each individual plays against every other individual twice
+        // Disable training once for the whole round: players are shared between
+        // workers and must stay read-only while matches are running. The
+        // quantized-inference setting only applies to the round as well.
+        vector<bool> trainingWas(n);
+        vector<bool> quantizedWas(n);
         for (int i = 0; i < n; i++) {
-            for (int j = 0; j < n; j++) {
-                if (i == j) continue;
-                
-                // Setup match
-                match->setupMatch(individuals[i].player, individuals[j].player);
-                
-                // Run match
-                MatchResult result = match->runHeadless(
-                    individuals[i].id, 
-                    individuals[j].id,
-                    config.speedMultiplier
-                );
-                
-                // Record results
-                if (result.winnerId == individuals[i].id) {
-                    individuals[i].recordMatch(true);
-                    individuals[j].recordMatch(false);
-                } else {
-                    individuals[i].recordMatch(false);
-                    individuals[j].recordMatch(true);
-                }
-                
-                currentMatch++;
+            trainingWas[i] = individuals[i].player->isTrainingEnabled();
+            quantizedWas[i] = individuals[i].player->getAgent().isQuantizedInference();
+            individuals[i].player->getAgent().setQuantizedInference(config.quantizedInference);
+            individuals[i].player->setTrainingEnabled(false);
+        }
+        
+        vector<MatchResult> results(totalMatches);
+        atomic<int> nextPairing(0);
+        roundDeadline = chrono::steady_clock::now() +
+            chrono::duration_cast<chrono::steady_clock::duration>(
+                chrono::duration<float>(config.generationTimeBudget));
+        
+        matchStartTimes.resize(totalMatches);
+        int workerCount = getWorkerCount(totalMatches);
+        
+        // Worker 0 is the calling thread; it also controls the round: it
+        // applies commands and publishes snapshots each time it claims a pairing
+        auto worker = [&](int workerIndex) {
+            if (config.eventDriven) {
+                runEventDrivenWorker(individuals, pairings, nextPairing, results, workerIndex);
+                return;
+            }
+            if (config.batchLanes > 0) {
+                runBatchedWorker(individuals, pairings, nextPairing, results, workerIndex, workerCount);
+                return;
+            }
+            
+            TournamentMatch workerMatch(windowWidth, windowHeight, config.pointsPerMatch, false);
+            
+            int p;
+            while ((p = claimPairing(nextPairing, totalMatches, workerIndex)) >= 0) {
+                const AIIndividual& home = individuals[pairings[p].first];
+                const AIIndividual& away = individuals[pairings[p].second];
                 
-                // Progress output removed
+                workerMatch.setupMatch(home.player.get(), away.player.get(), matchStream(p));
+                results[p] = workerMatch.runHeadless(home.id, away.id, config.timestep);
+                reportMatch(workerIndex, p, results[p]);
             }
+        };
+        
+        vector<thread> workers;
+        for (int w = 1; w < workerCount; w++) {
+            workers.emplace_back(worker, w);
+        }
+        worker(0);  // This thread works too
+        for (auto& t : workers) {
+            t.join();
         }
         
-        // Progress output removed
+        // Merge results in pairing order. Pairings left unplayed when the time
+        // budget ran out have no frames or events and count for nobody.
+        for (int p = 0; p < totalMatches; p++) {
+            if (results[p].totalFrames == 0 && results[p].totalEvents == 0) {
+                continue;
+            }
+            
+            AIIndividual& home = individuals[pairings[p].first];
+            AIIndividual& away = individuals[pairings[p].second];
+            
+            if (results[p].winnerId == home.id) {
+                home.recordMatch(true);
+                away.recordMatch(false);
+            } else {
+                home.recordMatch(false);
+                away.recordMatch(true);
+            }
+            
+            currentMatch++;
+        }
+        
+        // Restore training and inference state
+        for (int i = 0; i < n; i++) {
+            individuals[i].player->getAgent().setQuantizedInference(quantizedWas[i]);
+            individuals[i].player->setTrainingEnabled(trainingWas[i]);
+        }
+    }
+    
+    // Worker loop for batched simulation: keeps up to config.batchLanes matches
+    // in flight, refilling lanes from the shared pairing counter as they finish.
+    // Lanes are capped at this worker's share of the round, otherwise the
+    // first workers would claim every pairing before the others start (a
+    // 16-individual population has only 240 pairings for 128 lanes each).
+    void runBatchedWorker(const vector<AIIndividual>& individuals,
+                          const vector<pair<int, int>>& pairings,
+                          atomic<int>& nextPairing,
+                          vector<MatchResult>& results,
+                          int workerIndex, int workerCount) {
+        int share = ((int)pairings.size() + workerCount - 1) / workerCount;
+        BatchSimulator simulator(min(config.batchLanes, share), windowWidth, windowHeight,
+                                 config.pointsPerMatch, TournamentMatch::MAX_HEADLESS_FRAMES);
+        
+        auto nextJob = [&](BatchMatchJob& job) {
+            int p = claimPairing(nextPairing, pairings.size(), workerIndex);
+            if (p < 0) {
+                return false;
+            }
+            fillMatchJob(individuals, pairings, p, job);
+            return true;
+        };
+        
+        auto onFinished = [&](const BatchMatchOutcome& outcome) {
+            storeOutcome(individuals, pairings, outcome, results);
+            reportMatch(workerIndex, outcome.id, results[outcome.id]);
+            if (workerIndex == 0) {
+                pollControl(nextPairing.load());  // Lanes drain without claiming
+            }
+        };
+        
+        // A worker's lanes can hold most of the round, so the budget also
+        // ends matches in flight (they count for nobody, like unclaimed ones)
+        auto abandon = [&]() {
+            return budgetSpent();
+        };
+        
+        simulator.run(config.timestep, nextJob, onFinished, abandon);
+    }
+    
+    // Worker loop for event-driven simulation. Agents decide at most once per
+    // timestep, so decisions keep the same rate as the stepped modes.
+    void runEventDrivenWorker(const vector<AIIndividual>& individuals,
+                              const vector<pair<int, int>>& pairings,
+                              atomic<int>& nextPairing,
+                              vector<MatchResult>& results,
+                              int workerIndex) {
+        EventDrivenMatch eventMatch(windowWidth, windowHeight, config.pointsPerMatch,
+                                    config.timestep, TournamentMatch::MAX_HEADLESS_FRAMES);
+        
+        int p;
+        while ((p = claimPairing(nextPairing, pairings.size(), workerIndex)) >= 0) {
+            BatchMatchJob job;
+            fillMatchJob(individuals, pairings, p, job);
+            storeOutcome(individuals, pairings, eventMatch.run(job), results);
+            reportMatch(workerIndex, p, results[p]);
+        }
+    }
+    
+    // Next pairing for a worker, or -1 when all are taken, the tournament
+    // was stopped or the generation's time budget is spent (matches already
+    // running still finish, except batched lanes). Workers wait here while the tournament is paused;
+    // worker 0 applies commands meanwhile.
+    int claimPairing(atomic<int>& nextPairing, int pairingCount, int workerIndex) {
+        bool controller = (workerIndex == 0);
+        if (controller) {
+            pollControl(nextPairing.load());
+        }
+        while (state == TournamentState::Paused && nextPairing.load() < pairingCount) {
+            this_thread::sleep_for(chrono::milliseconds(CONTROL_POLL_MS));
+            if (controller) {
+                pollControl(nextPairing.load());
+            }
+        }
+        if (state == TournamentState::Idle) {
+            return -1;
+        }
+        if (budgetSpent()) {
+            return -1;
+        }
+        int p = nextPairing.fetch_add(1);
+        if (p >= pairingCount) {
+            return -1;
+        }
+        matchStartTimes[p] = chrono::steady_clock::now();
+        return p;
+    }
+    
+    // True once the generation has used its wall-clock budget
+    bool budgetSpent() const {
+        return config.generationTimeBudget > 0.0f && chrono::steady_clock::now() >= roundDeadline;
+    }
+    
+    // Publish pairing p's result to the telemetry feed (worker workerIndex)
+    void reportMatch(int workerIndex, int p, const MatchResult& result) {
+        MatchTelemetry event;
+        event.generation = currentGeneration;
+        event.pairing = p;
+        event.setIds(result.player1Id, result.player2Id);
+        event.homeScore = result.player1Score;
+        event.awayScore = result.player2Score;
+        event.frames = result.totalFrames;
+        event.events = result.totalEvents;
+        event.simTime = result.duration;
+        event.wallTime = chrono::duration<float>(chrono::steady_clock::now() - matchStartTimes[p]).count();
+        telemetry.push(workerIndex, event);
+    }
+    
+    // Random stream of pairing p in the current generation: the same seed,
+    // generation and pairing always replay the same match, on any thread
+    RandomStream matchStream(int p) const {
+        return RandomStream(RandomStream::mix(tournamentSeed, currentGeneration), p);
+    }
+    
+    void fillMatchJob(const vector<AIIndividual>& individuals,
+                      const vector<pair<int, int>>& pairings,
+                      int p, BatchMatchJob& job) const {
+        const AIPlayer* players[2] = {
+            individuals[pairings[p].first].player.get(),
+            individuals[pairings[p].second].player.get()
+        };
+        job.id = p;
+        job.rng = matchStream(p);
+        for (int s = 0; s < 2; s++) {
+            job.sides[s].agent = &players[s]->getAgent();
+            job.sides[s].params = players[s]->getPaddleParams();
+            job.sides[s].width = players[s]->getSize().x;
+            job.sides[s].height = players[s]->getSize().y;
+        }
+    }
+    
+    void storeOutcome(const vector<AIIndividual>& individuals,
+                      const vector<pair<int, int>>& pairings,
+                      const BatchMatchOutcome& outcome,
+                      vector<MatchResult>& results) const {
+        const AIIndividual& home = individuals[pairings[outcome.id].first];
+        const AIIndividual& away = individuals[pairings[outcome.id].second];
+        
+        MatchResult& result = results[outcome.id];
+        result.player1Id = home.id;
+        result.player2Id = away.id;
+        result.player1Score = outcome.scores[0];
+        result.player2Score = outcome.scores[1];
+        result.winnerId = (outcome.scores[0] >= config.pointsPerMatch) ? home.id : away.id;
+        result.totalFrames = outcome.frames;
+        result.totalEvents = outcome.events;
+        result.duration = outcome.duration;
     }
     
     // Save top 5 for persistence between tournaments
     void saveTop5ForPersistence() {
-        population->sortByFitness();
-        
         // Create directory if it doesn't exist
         #ifdef _WIN32
             system("mkdir \"models\" 2>NUL");
@@ -483,7 +967,7 @@ private:
         
         // Save top 5 models
         for (int i = 0; i < min(5, (int)population->getSize()); i++) {
-            const auto& ind = population->getIndividual(i);
+            const auto& ind = population->getRanked(i);
             
             if (ind.player) {
                 stringstream ss;
@@ -515,7 +999,7 @@ private:
         
         // Save tournament winner (#1) separately for next tournament
         if (population->getSize() > 0) {
-            const auto& winner = population->getIndividual(0);
+            const auto& winner = population->getBest();
             if (winner.player) {
                 ModelSaver::saveModel(
                     winner.player->getAgent().getNetwork(), 
@@ -640,7 +1124,7 @@ private:
                 ModelSaver::loadModel(ind.player->getAgent().getNetwork(), modelFile);
             }
             
-            individuals.push_back(ind);
+            individuals.push_back(move(ind));
             loadedCount++;
         }
         
@@ -651,6 +1135,7 @@ private:
             string id = population->generateNewId();
             individuals.emplace_back(id, 0, genes, x, y);
         }
+        population->shareReplay();
         
         // Progress output removed
         return loadedCount > 0;
@@ -748,10 +1233,8 @@ private:
             system(("mkdir -p \"" + genDir + "\"").c_str());
         #endif
         
-        population->sortByFitness();
-        
         for (int i = 0; i < min(topN, (int)population->getSize()); i++) {
-            const auto& ind = population->getIndividual(i);
+            const auto& ind = population->getRanked(i);
             
             // Create filename
             stringstream ss;
@@ -935,9 +1418,8 @@ public:
             }
         } else {
             // Fallback to current population if cache is empty
-            population->sortByFitness();
             for (int i = 0; i < min(n, (int)population->getSize()); i++) {
-                candidates.push_back(&population->getIndividual(i));
+                candidates.push_back(&population->getRanked(i));
             }
         }
         
@@ -969,8 +1451,10 @@ public:
         return top;
     }
     
-    // Watch a match between two specific individuals
+    // Watch a match between two individuals, given by fitness rank (0 = best)
     void watchMatch(int individual1Idx, int individual2Idx) {
+        stopBackground();
+        
         if (individual1Idx < 0 || individual1Idx >= population->getSize() ||
             individual2Idx < 0 || individual2Idx >= population->getSize()) {
             cerr << "Invalid individual indices!" << endl;
@@ -980,13 +1464,13 @@ public:
         // Create visual match
         TournamentMatch visualMatch(windowWidth, windowHeight, config.pointsPerMatch, true);
         
-        auto& ind1 = population->getIndividual(individual1Idx);
-        auto& ind2 = population->getIndividual(individual2Idx);
+        auto& ind1 = population->getRanked(individual1Idx);
+        auto& ind2 = population->getRanked(individual2Idx);
         
         // Progress output removed
         
-        visualMatch.setupMatch(ind1.player, ind2.player);
-        MatchResult result = visualMatch.runVisual(ind1.id, ind2.id);
+        visualMatch.setupMatch(ind1.player.get(), ind2.player.get());
+        MatchResult result = visualMatch.runVisual(ind1.id, ind2.id, config.speedMultiplier, config.timestep);
         
         // Progress output removed
     }
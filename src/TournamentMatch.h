@@ -2,7 +2,8 @@
 
 #include "AIPlayer.h"
 #include "Ball.h"
-#include "Collisions.h"
+#include "AgentControl.h"
+#include "Random.h"
 #include <SFML/Graphics.hpp>
 #include <iostream>
 
@@ -16,19 +17,27 @@ struct MatchResult {
     int player2Score;
     string winnerId;
     int totalFrames;
+    int totalEvents;  // Event-driven matches count events instead of frames
     float duration;  // in seconds
     
     MatchResult() 
         : player1Id("0000"), player2Id("0000"), player1Score(0), player2Score(0),
-          winnerId("0000"), totalFrames(0), duration(0.0f) {}
+          winnerId("0000"), totalFrames(0), totalEvents(0), duration(0.0f) {}
 };
 
 // Tournament match simulator (headless or visual)
+// The match runs on a MatchPhysicsState; players are only asked for decisions,
+// so each tournament worker can own one of these and share the players.
+// SFML objects (window, ball sprite) exist only in visual mode.
 class TournamentMatch {
 private:
     AIPlayer* player1;
     AIPlayer* player2;
-    Ball* ball;
+    PaddleParams params1;
+    PaddleParams params2;
+    
+    MatchPhysicsState physics;
+    Ball* ball;  // Visual mode only, mirrors physics for drawing
     
     int winScore;
     int windowWidth;
@@ -37,28 +46,36 @@ private:
     bool visualMode;
     sf::RenderWindow* window;
     
-    // Collision tracking
-    bool lastBallHitPlayer1;
-    bool lastBallHitPlayer2;
-    
     // Match state
     int currentFrames;
     float currentTime;
     
+    // Serve and exploration randomness of the current match
+    RandomStream rng;
+    
 public:
+    // Physics always advances in fixed steps, whatever the playback speed
+    static constexpr float BASE_TIMESTEP = 1.0f / 60.0f;
+    static constexpr float FINE_TIMESTEP = 1.0f / 120.0f;
+    static constexpr int MAX_HEADLESS_FRAMES = 100000;  // Prevent infinite loops
+    static constexpr int MAX_SUBSTEPS_PER_FRAME = 1000;  // Visual mode catch-up limit
+    
     TournamentMatch(int width, int height, int winningScore = 7, bool visual = false)
         : player1(nullptr), player2(nullptr), ball(nullptr),
           winScore(winningScore), windowWidth(width), windowHeight(height),
           visualMode(visual), window(nullptr),
-          lastBallHitPlayer1(false), lastBallHitPlayer2(false),
           currentFrames(0), currentTime(0.0f) {
         
+        physics.fieldWidth = width;
+        physics.fieldHeight = height;
+        
         if (visualMode) {
             window = new sf::RenderWindow(sf::VideoMode(width, height), 
                                          "Tournament Match", 
                                          sf::Style::Titlebar | sf::Style::Close);
             window->setVerticalSyncEnabled(false);
             window->setFramerateLimit(60);
+            ball = new Ball(width, height);
         }
     }
     
@@ -74,53 +91,59 @@ public:
         }
     }
     
-    // Setup match with two AI players
+    // Setup match with two AI players (unseeded: for watched matches)
     void setupMatch(AIPlayer* p1, AIPlayer* p2) {
+        setupMatch(p1, p2, RandomSeeds::next());
+    }
+    
+    // Setup match with its own random stream, so the match can be replayed
+    void setupMatch(AIPlayer* p1, AIPlayer* p2, const RandomStream& stream) {
+        rng = stream;
         player1 = p1;
         player2 = p2;
+        params1 = player1->getPaddleParams();
+        params2 = player2->getPaddleParams();
         
         // Position players on opposite sides
         // Player 1 on left, Player 2 on right
-        float paddleWidth = player1->getSize().x;
-        float paddleHeight = player1->getSize().y;
-        float centerY = windowHeight / 2.0f - paddleHeight / 2.0f;
-        
-        player1->setPosition(35.0f, centerY);  // Left side
-        player2->setPosition(windowWidth - 50.0f, centerY);  // Right side
+        PaddleState& left = physics.paddles[0];
+        left = PaddleState();
+        left.width = player1->getSize().x;
+        left.height = player1->getSize().y;
+        left.x = 35.0f;
+        left.y = windowHeight / 2.0f - left.height / 2.0f;
         
-        // Reset scores
-        player1->setScore(0);
-        player2->setScore(0);
+        PaddleState& right = physics.paddles[1];
+        right = PaddleState();
+        right.width = player2->getSize().x;
+        right.height = player2->getSize().y;
+        right.x = windowWidth - 50.0f;
+        right.y = windowHeight / 2.0f - right.height / 2.0f;
         
-        // Create ball
-        if (ball) delete ball;
-        ball = new Ball(windowWidth, windowHeight);
-        ball->reset();
+        // Serve
+        MatchPhysics::serveBall(physics, rng);
         
-        lastBallHitPlayer1 = false;
-        lastBallHitPlayer2 = false;
+        physics.lastBallHit[0] = false;
+        physics.lastBallHit[1] = false;
         currentFrames = 0;
         currentTime = 0.0f;
     }
     
     // Run match to completion (headless)
-    MatchResult runHeadless(const string& player1Id, const string& player2Id, float speedMultiplier = 1.0f) {
-        if (!player1 || !player2 || !ball) {
+    // The caller disables training on both players beforehand (TournamentManager
+    // does it once per round) so concurrent matches never toggle shared state.
+    // Runs as fast as the CPU allows; the timestep only sets physics accuracy.
+    MatchResult runHeadless(const string& player1Id, const string& player2Id, float timestep = BASE_TIMESTEP) {
+        if (!player1 || !player2) {
             cerr << "Match not properly set up!" << endl;
             return MatchResult();
         }
         
-        // Disable training during tournament matches
-        bool p1TrainingWas = player1->isTrainingEnabled();
-        bool p2TrainingWas = player2->isTrainingEnabled();
-        player1->setTrainingEnabled(false);
-        player2->setTrainingEnabled(false);
-        
-        const float dt = 0.016f * speedMultiplier;  // ~60 FPS base
-        const int maxFrames = 100000;  // Prevent infinite loops
+        const float dt = timestep;
+        const int maxFrames = MAX_HEADLESS_FRAMES;
         
-        while (player1->getScore() < winScore && 
-               player2->getScore() < winScore && 
+        while (physics.paddles[0].score < winScore && 
+               physics.paddles[1].score < winScore && 
                currentFrames < maxFrames) {
             
             // Update game logic
@@ -129,25 +152,14 @@ public:
             currentFrames++;
         }
         
-        // Restore training state
-        player1->setTrainingEnabled(p1TrainingWas);
-        player2->setTrainingEnabled(p2TrainingWas);
-        
-        // Create result
-        MatchResult result;
-        result.player1Id = player1Id;
-        result.player2Id = player2Id;
-        result.player1Score = player1->getScore();
-        result.player2Score = player2->getScore();
-        result.winnerId = (player1->getScore() >= winScore) ? player1Id : player2Id;
-        result.totalFrames = currentFrames;
-        result.duration = currentTime;
-        
-        return result;
+        return buildResult(player1Id, player2Id);
     }
     
     // Run match with visualization
-    MatchResult runVisual(const string& player1Id, const string& player2Id) {
+    // speedMultiplier is simulated seconds per wall-clock second: each rendered
+    // frame runs as many fixed substeps as that takes.
+    MatchResult runVisual(const string& player1Id, const string& player2Id,
+                          float speedMultiplier = 1.0f, float timestep = BASE_TIMESTEP) {
         if (!player1 || !player2 || !ball || !window) {
             cerr << "Match not properly set up for visual mode!" << endl;
             return MatchResult();
@@ -160,10 +172,11 @@ public:
         player2->setTrainingEnabled(false);
         
         sf::Clock clock;
+        float accumulator = 0.0f;
         
         while (window->isOpen() && 
-               player1->getScore() < winScore && 
-               player2->getScore() < winScore) {
+               physics.paddles[0].score < winScore && 
+               physics.paddles[1].score < winScore) {
             
             float dt = clock.restart().asSeconds();
             if (dt > 0.1f) dt = 0.1f;  // Cap delta time
@@ -180,12 +193,30 @@ public:
                 }
             }
             
-            // Update
-            updateGameLogic(dt);
-            currentTime += dt;
-            currentFrames++;
+            // Update in fixed substeps
+            accumulator += dt * speedMultiplier;
+            int substeps = 0;
+            while (accumulator >= timestep && substeps < MAX_SUBSTEPS_PER_FRAME &&
+                   physics.paddles[0].score < winScore &&
+                   physics.paddles[1].score < winScore) {
+                updateGameLogic(timestep);
+                currentTime += timestep;
+                currentFrames++;
+                accumulator -= timestep;
+                substeps++;
+            }
+            if (substeps == MAX_SUBSTEPS_PER_FRAME) {
+                accumulator = 0.0f;  // Too slow to keep up: drop the backlog
+            }
+            
+            // Render: copy the simulation state into the SFML objects
+            player1->setPosition(physics.paddles[0].x, physics.paddles[0].y);
+            player2->setPosition(physics.paddles[1].x, physics.paddles[1].y);
+            player1->setScore(physics.paddles[0].score);
+            player2->setScore(physics.paddles[1].score);
+            ball->sprite.setPosition(physics.ballX, physics.ballY);
+            ball->dir = sf::Vector2f(physics.ballDirX, physics.ballDirY);
             
-            // Render
             window->clear(sf::Color::Black);
             player1->render(*window);
             player2->render(*window);
@@ -201,69 +232,31 @@ public:
         player1->setTrainingEnabled(p1TrainingWas);
         player2->setTrainingEnabled(p2TrainingWas);
         
-        // Create result
+        return buildResult(player1Id, player2Id);
+    }
+    
+private:
+    MatchResult buildResult(const string& player1Id, const string& player2Id) const {
         MatchResult result;
         result.player1Id = player1Id;
         result.player2Id = player2Id;
-        result.player1Score = player1->getScore();
-        result.player2Score = player2->getScore();
-        result.winnerId = (player1->getScore() >= winScore) ? player1Id : player2Id;
+        result.player1Score = physics.paddles[0].score;
+        result.player2Score = physics.paddles[1].score;
+        result.winnerId = (physics.paddles[0].score >= winScore) ? player1Id : player2Id;
         result.totalFrames = currentFrames;
         result.duration = currentTime;
         
         return result;
     }
     
-private:
+    // Training is always disabled during tournament matches, so no experience
+    // is recorded here; players are only asked for decisions.
     void updateGameLogic(float dt) {
         // Update players
-        player1->update(*ball, dt, windowHeight, windowWidth);
-        player2->update(*ball, dt, windowHeight, windowWidth);
-        
-        // Update ball
-        ball->move(dt, windowWidth, windowHeight);
-        
-        // Check collisions
-        bool currentBallHitPlayer1 = Collisions::check(ball->getBounds(), player1->getBounds());
-        bool currentBallHitPlayer2 = Collisions::check(ball->getBounds(), player2->getBounds());
-        
-        // Handle collisions
-        if (currentBallHitPlayer1 && !lastBallHitPlayer1) {
-            ball->dir.x *= -1;
-            vector<float> currentState = player1->getCurrentState(*ball, windowHeight);
-            player1->recordExperience(true, false, false, false, currentState);
-        }
+        MatchPhysics::updateAIPaddle(physics, 0, params1, player1->getAgent(), dt, rng);
+        MatchPhysics::updateAIPaddle(physics, 1, params2, player2->getAgent(), dt, rng);
         
-        if (currentBallHitPlayer2 && !lastBallHitPlayer2) {
-            ball->dir.x *= -1;
-            vector<float> currentState = player2->getCurrentState(*ball, windowHeight);
-            player2->recordExperience(true, false, false, false, currentState);
-        }
-        
-        lastBallHitPlayer1 = currentBallHitPlayer1;
-        lastBallHitPlayer2 = currentBallHitPlayer2;
-        
-        // Check for scoring
-        int scoreResult = ball->checkScore(windowWidth);
-        if (scoreResult == 1) {
-            // Left player (player1) scored
-            player1->incrementScore();
-            bool gameWon = (player1->getScore() >= winScore);
-            player1->recordPointExperience(true, gameWon);
-            player2->recordPointExperience(false, gameWon);
-            ball->reset();
-            lastBallHitPlayer1 = false;
-            lastBallHitPlayer2 = false;
-        } else if (scoreResult == 2) {
-            // Right player (player2) scored
-            player2->incrementScore();
-            bool gameWon = (player2->getScore() >= winScore);
-            player2->recordPointExperience(true, gameWon);
-            player1->recordPointExperience(false, gameWon);
-            ball->reset();
-            lastBallHitPlayer1 = false;
-            lastBallHitPlayer2 = false;
-        }
+        // Update ball, collisions and scoring
+        MatchPhysics::stepBall(physics, dt, rng);
     }
 };
-
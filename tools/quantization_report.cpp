@@ -0,0 +1,133 @@
+// Compares an agent's float network with its int8-quantized copy
+// (QuantizedNetwork) on states from headless self-play plus uniformly random
+// states, and reports how often the greedy action changes.
+//
+//   bin/quantization_report [model.bin ...]
+//
+// Without arguments a few freshly initialized 6-N-3 networks are checked.
+// Needs no SFML: build with `make quantization-report`.
+
+#include "../src/AgentControl.h"
+#include "../src/QuantizedNetwork.h"
+#include "../src/ModelSaver.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+
+static const int SELF_PLAY_FRAMES = 20000;
+static const int RANDOM_STATES = 20000;
+
+// States both paddles see while the network plays against itself
+static vector<AgentState> collectSelfPlayStates(const NeuralNetwork& network, RandomStream& rng) {
+    QLearningAgent agent(6, 3, network.getLayerSizes()[1]);
+    network.copyTo(agent.getNetwork());
+    agent.setTrainingEnabled(false);
+
+    MatchPhysicsState state;
+    state.paddles[0].x = 35.0f;
+    state.paddles[1].x = state.fieldWidth - 50.0f;
+    for (int side = 0; side < 2; side++) {
+        state.paddles[side].y = state.fieldHeight / 2.0f - state.paddles[side].height / 2.0f;
+    }
+    MatchPhysics::serveBall(state, rng);
+
+    PaddleParams params;
+    const float dt = 1.0f / 60.0f;
+    vector<AgentState> states;
+    states.reserve(SELF_PLAY_FRAMES * 2);
+    for (int frame = 0; frame < SELF_PLAY_FRAMES; frame++) {
+        for (int side = 0; side < 2; side++) {
+            const PaddleState& paddle = state.paddles[side];
+            states.push_back(MatchPhysics::normalizeState(state.ballX, state.ballY,
+                                                          state.ballDirX, state.ballDirY,
+                                                          paddle.y, paddle.height));
+            MatchPhysics::updateAIPaddle(state, side, params, agent, dt, rng);
+        }
+        MatchPhysics::stepBall(state, dt, rng);
+    }
+    return states;
+}
+
+static vector<AgentState> collectRandomStates(RandomStream& rng) {
+    vector<AgentState> states(RANDOM_STATES);
+    for (AgentState& s : states) {
+        for (int i = 0; i < AgentState::SIZE; i++) {
+            s[i] = rng.nextFloat();
+        }
+    }
+    return states;
+}
+
+static void report(const string& label, const NeuralNetwork& network,
+                   const QuantizedNetwork& quantized, const vector<AgentState>& states) {
+    int outputSize = network.getLayerSizes().back();
+    vector<float> exact(outputSize);
+    vector<float> approx(outputSize);
+    int disagreements = 0;
+    float maxError = 0.0f;
+
+    for (const AgentState& s : states) {
+        network.predictQValuesInto(s.data(), exact.data());
+        quantized.predictQValuesInto(s.data(), approx.data());
+        int a = max_element(exact.begin(), exact.end()) - exact.begin();
+        int b = max_element(approx.begin(), approx.end()) - approx.begin();
+        if (a != b) {
+            disagreements++;
+        }
+        for (int i = 0; i < outputSize; i++) {
+            maxError = max(maxError, fabs(exact[i] - approx[i]));
+        }
+    }
+
+    cout << "  " << left << setw(10) << label << right
+         << setw(8) << states.size() << " states, "
+         << setw(6) << disagreements << " argmax changes ("
+         << fixed << setprecision(3) << 100.0 * disagreements / max<size_t>(1, states.size())
+         << "%), max |dQ| " << scientific << setprecision(2) << maxError
+         << defaultfloat << endl;
+}
+
+static void check(const string& name, const NeuralNetwork& network, RandomStream& rng) {
+    QuantizedNetwork quantized;
+    quantized.freeze(network);
+
+    cout << name << " (";
+    const vector<int>& sizes = network.getLayerSizes();
+    for (size_t i = 0; i < sizes.size(); i++) {
+        cout << (i ? "-" : "") << sizes[i];
+    }
+    cout << ")" << endl;
+
+    if (sizes.size() == 3 && sizes[0] == AgentState::SIZE) {
+        report("self-play", network, quantized, collectSelfPlayStates(network, rng));
+    }
+    report("random", network, quantized, collectRandomStates(rng));
+}
+
+int main(int argc, char* argv[]) {
+    RandomStream rng(12345);
+
+    if (argc < 2) {
+        const int hiddenSizes[] = { 8, 12, 16, 24 };
+        for (int hidden : hiddenSizes) {
+            NeuralNetwork network(6, hidden, 3);
+            check("random init", network, rng);
+        }
+        return 0;
+    }
+
+    int failed = 0;
+    for (int i = 1; i < argc; i++) {
+        NeuralNetwork network(6, 12, 3);
+        if (!ModelSaver::loadModel(network, argv[i])) {
+            failed++;
+            continue;
+        }
+        check(argv[i], network, rng);
+    }
+    return failed == 0 ? 0 : 1;
+}